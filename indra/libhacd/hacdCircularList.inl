@@ -212,7 +212,11 @@ namespace HACD
         if (&rhs != this)
         {
             Clear();
-            m_heapManager = rhs.m_heapManager;
+            // a list that has its own heap keeps allocating from it
+            if (!m_heapManager)
+            {
+                m_heapManager = rhs.m_heapManager;
+            }
             if (rhs.m_size > 0)
             {
                 CircularListElement<T> * current = rhs.m_head;
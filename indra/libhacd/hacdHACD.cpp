@@ -22,6 +22,9 @@
 #include <limits>
 #include "hacdMeshDecimator.h"
 #include "hacdRaycastMesh.h"
+#include "hacdMicroAllocator.h"
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
 //#define HACD_DEBUG
 namespace HACD
 { 
@@ -431,6 +434,7 @@ namespace HACD
 		m_flatRegionThreshold = 1.0;
 		m_smallClusterThreshold = 0.25;
 		m_area = 0.0;					
+        m_nThreads = 1;
 	}																
 	HACD::~HACD(void)
 	{
@@ -446,6 +450,10 @@ namespace HACD
 	}
 
     void HACD::ComputeEdgeCost(size_t e)
+    {
+		ComputeEdgeCost(e, CreateEdgeHull(e, m_heapManager));
+	}
+    ICHull * HACD::CreateEdgeHull(size_t e, HeapManager * heapManager)
     {
 		GraphEdge & gE = m_graph.m_edges[e];
         long v1 = gE.m_v1;
@@ -458,8 +466,8 @@ namespace HACD
 			std::swap(v1, v2);
         }
 		GraphVertex & gV1 = m_graph.m_vertices[v1];
-		GraphVertex & gV2 = m_graph.m_vertices[v2];
 #ifdef HACD_DEBUG
+		GraphVertex & gV2 = m_graph.m_vertices[v2];
 		if (v1 == 308 && v2==276)
 		{
 			gV1.m_convexHull->m_mesh.Save("debug1.wrl");
@@ -468,14 +476,24 @@ namespace HACD
 
 #endif
 	
-        // create the edge's convex-hull
-        ICHull  * ch = new ICHull(m_heapManager);
+        // create the edge's convex-hull (copying modifies the source mesh, so this is never done concurrently)
+        ICHull  * ch = new ICHull(heapManager);
         (*ch) = (*gV1.m_convexHull);       
-		// update distPoints
 #ifdef HACD_PRECOMPUTE_CHULLS
         delete gE.m_convexHull;
         gE.m_convexHull = 0;
 #endif
+		return ch;
+	}
+    void HACD::ComputeEdgeCost(size_t e, ICHull * ch)
+    {
+		GraphEdge & gE = m_graph.m_edges[e];
+        long v1 = gE.m_v1;
+        long v2 = gE.m_v2;
+		GraphVertex & gV1 = m_graph.m_vertices[v1];
+		GraphVertex & gV2 = m_graph.m_vertices[v2];
+		HeapManager * heapManager = ch->GetHeapManager();
+		// update distPoints
         std::map<long, DPoint> distPoints;
 		for(size_t p = 0; p < gV1.m_distPoints.Size(); ++p) 
 		{
@@ -512,7 +530,7 @@ namespace HACD
 		{
 //			if (m_callBack) (*m_callBack)("\t Problem with convex-hull construction [HACD::ComputeEdgeCost]\n", 0.0, 0.0, 0);
             ICHull  * chOld = ch;
-			ch = new ICHull(m_heapManager);
+			ch = new ICHull(heapManager);
 			CircularList<TMMVertex> & verticesCH = chOld->GetMesh().m_vertices;
 			size_t nV = verticesCH.GetSize();
 			long ptIndex = 0;
@@ -614,13 +632,71 @@ namespace HACD
 		double volume  = volumeCH/pow(m_scale, 3.0);	// cluster's volume
         gE.m_error     = static_cast<Real>(concavity +  m_alpha * (1.0 - weightFlat) * ratio + m_beta * volume + m_gamma * static_cast<double>(distPoints.size()) / m_nPoints);	// cluster's priority
 	}
+    void HACD::ComputeEdgeCostsRange(const std::vector<long> & edges, const std::vector<ICHull *> & hulls, size_t first, size_t stride)
+    {
+        for (size_t i = first; i < edges.size(); i += stride)
+        {
+            ComputeEdgeCost(edges[i], hulls[i]);
+        }
+    }
+    void HACD::ComputeEdgeCosts(const std::vector<long> & edges)
+    {
+        size_t nThreads = m_nThreads;
+        if (nThreads == 0)
+        {
+            nThreads = std::max<size_t>(1, boost::thread::hardware_concurrency());
+        }
+        nThreads = std::min(nThreads, edges.size());
+        if (nThreads < 2)
+        {
+            for (size_t i = 0; i < edges.size(); ++i)
+            {
+                ComputeEdgeCost(edges[i]);
+            }
+            return;
+        }
+        // every thread allocates its convex-hulls from its own heap
+        std::vector<HeapManager *> heaps(nThreads);
+        for (size_t t = 0; t < nThreads; ++t)
+        {
+            heaps[t] = acquireHeapManager();
+        }
+        std::vector<ICHull *> hulls(edges.size());
+        for (size_t i = 0; i < edges.size(); ++i)
+        {
+            hulls[i] = CreateEdgeHull(edges[i], heaps[i % nThreads]);
+        }
+        boost::thread_group workers;
+        for (size_t t = 1; t < nThreads; ++t)
+        {
+            workers.create_thread(boost::bind(&HACD::ComputeEdgeCostsRange, this, boost::cref(edges), boost::cref(hulls), t, nThreads));
+        }
+        ComputeEdgeCostsRange(edges, hulls, 0, nThreads);
+        workers.join_all();
+        for (size_t t = 0; t < nThreads; ++t)
+        {
+            recycleHeapManager(heaps[t]);
+        }
+    }
     bool HACD::InitializePriorityQueue()
     {
 		m_pqueue.reserve(m_graph.m_nE + 100);
+        // edges are processed in batches to bound the number of convex-hulls alive at the same time
+        const size_t batchSize = 256;
+        std::vector<long> edges;
+        edges.reserve(batchSize);
         for (size_t e=0; e < m_graph.m_nE; ++e) 
         {
-            ComputeEdgeCost(static_cast<long>(e));
-			m_pqueue.push(GraphEdgePriorityQueue(static_cast<long>(e), m_graph.m_edges[e].m_error));
+            edges.push_back(static_cast<long>(e));
+            if (edges.size() == batchSize || e + 1 == m_graph.m_nE)
+            {
+                ComputeEdgeCosts(edges);
+                for (size_t i = 0; i < edges.size(); ++i)
+                {
+                    m_pqueue.push(GraphEdgePriorityQueue(edges[i], m_graph.m_edges[edges[i]].m_error));
+                }
+                edges.clear();
+            }
         }
 		return true;
     }
@@ -855,12 +931,15 @@ namespace HACD
 					printf("v1 %i v2 %i \n", v1, v2);
 	#endif
 					m_graph.EdgeCollapse(v1, v2);
-					long idEdge;
-					for(size_t itE = 0; itE < m_graph.m_vertices[v1].m_edges.Size(); ++itE)
+					std::vector<long> edges(m_graph.m_vertices[v1].m_edges.Size());
+					for(size_t itE = 0; itE < edges.size(); ++itE)
+					{
+						edges[itE] = m_graph.m_vertices[v1].m_edges[itE];
+					}
+					ComputeEdgeCosts(edges);
+					for(size_t itE = 0; itE < edges.size(); ++itE)
 					{
-						idEdge = m_graph.m_vertices[v1].m_edges[itE];
-						ComputeEdgeCost(idEdge);
-						m_pqueue.push(GraphEdgePriorityQueue(idEdge, m_graph.m_edges[idEdge].m_error));
+						m_pqueue.push(GraphEdgePriorityQueue(edges[itE], m_graph.m_edges[edges[itE]].m_error));
 					}
 				}
 			}
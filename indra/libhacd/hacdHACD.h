@@ -115,6 +115,13 @@ namespace HACD
 		//! @return pointer to the call-back function
 		const CallBackFunction                      GetCallBack() const { return m_callBack;}
         
+        //! Sets the number of threads used to compute the edges costs (default 1, 0 = one per hardware thread)
+		//! @param nThreads number of threads
+		void										SetNThreads(size_t nThreads) { m_nThreads = nThreads;}
+		//! Gives the number of threads used to compute the edges costs
+		//! @return number of threads
+		const size_t								GetNThreads() const { return m_nThreads;}
+
         //! Specifies whether faces points should be added when computing the concavity
 		//! @param addFacesPoints true = faces points should be added
 		void										SetAddFacesPoints(bool  addFacesPoints) { m_addFacesPoints = addFacesPoints;}
@@ -262,6 +269,20 @@ namespace HACD
 		//! Computes the cost of an edge
 		//! @param e edge's id
         void                                        ComputeEdgeCost(size_t e);
+		//! Orients an edge and copies the convex-hull of its first vertex
+		//! @param e edge's id
+		//! @param heapManager heap used by the returned convex-hull
+		//! @return the edge's initial convex-hull
+        ICHull *                                    CreateEdgeHull(size_t e, HeapManager * heapManager);
+		//! Computes the cost of an edge from the convex-hull returned by CreateEdgeHull(), which is deleted
+		//! @param e edge's id
+		//! @param ch the edge's initial convex-hull
+        void                                        ComputeEdgeCost(size_t e, ICHull * ch);
+		//! Computes the costs of a set of edges, in parallel when more than one thread is allowed
+		//! @param edges edges ids
+        void                                        ComputeEdgeCosts(const std::vector<long> & edges);
+		//! Computes the costs of every stride-th edge starting with first, on the calling thread
+        void                                        ComputeEdgeCostsRange(const std::vector<long> & edges, const std::vector<ICHull *> & hulls, size_t first, size_t stride);
 		//! Initializes the priority queue
 		//! @param fast specifies whether fast mode is used
 		//! @return true if success
@@ -314,6 +335,7 @@ namespace HACD
 		long *										m_partition;				//>! array of size m_nTriangles where the i-th element specifies the cluster to which belong the i-th triangle
 		size_t										m_targetNTrianglesDecimatedMesh; //>! specifies the target number of triangles in the decimated mesh. If set to 0 no decimation is applied.
         HeapManager *                               m_heapManager;              //>! Heap Manager
+        size_t                                      m_nThreads;                 //>! number of threads used to compute the edges costs
         bool                                        m_addFacesPoints;           //>! specifies whether to add faces points or not
         bool                                        m_addExtraDistPoints;       //>! specifies whether to add extra points for concave shapes or not
 
@@ -800,7 +800,10 @@ namespace HACD
             m_edgesToUpdate = rhs.m_edgesToUpdate;
             m_trianglesToDelete = rhs.m_trianglesToDelete;
 			m_isFlat = rhs.m_isFlat;
-            m_heapManager = rhs.m_heapManager;
+            if (!m_heapManager)
+            {
+                m_heapManager = rhs.m_heapManager;
+            }
         }
         return (*this);
     }   
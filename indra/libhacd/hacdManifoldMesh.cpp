@@ -290,7 +290,10 @@ namespace HACD
         m_vertices  = mesh.m_vertices;
         m_edges     = mesh.m_edges;
         m_triangles = mesh.m_triangles;
-        m_heapManager = mesh.m_heapManager;
+        if (!m_heapManager)
+        {
+            m_heapManager = mesh.m_heapManager;
+        }
  
         // generating mapping
         CircularListElement<TMMVertex> ** vertexMap     = new CircularListElement<TMMVertex> * [nV];
@@ -38,6 +38,8 @@
 
 
 #include <new>
+#include <vector>
+#include <boost/thread/mutex.hpp>
 #include <assert.h>
 #include <string.h>
 #include <stdlib.h>
@@ -861,6 +863,43 @@ void          releaseHeapManager(HeapManager *heap)
 }
 
 
+// Heap managers that are currently not used by any thread.
+static boost::mutex               gRecycledHeapsMutex;
+static std::vector<HeapManager *> gRecycledHeaps;
+static const size_t               MAX_RECYCLED_HEAPS = 32;
+
+HeapManager * acquireHeapManager(void)
+{
+    {
+        boost::mutex::scoped_lock lock(gRecycledHeapsMutex);
+        if ( !gRecycledHeaps.empty() )
+        {
+            HeapManager *heap = gRecycledHeaps.back();
+            gRecycledHeaps.pop_back();
+            return heap;
+        }
+    }
+    return createHeapManager();
+}
+
+void          recycleHeapManager(HeapManager *heap)
+{
+    if ( !heap )
+    {
+        return;
+    }
+    {
+        boost::mutex::scoped_lock lock(gRecycledHeapsMutex);
+        if ( gRecycledHeaps.size() < MAX_RECYCLED_HEAPS )
+        {
+            gRecycledHeaps.push_back(heap);
+            return;
+        }
+    }
+    releaseHeapManager(heap);
+}
+
+
 #define TEST_SIZE 63
 #define TEST_ALLOC_COUNT 8192
 #define TEST_RUN 40000000
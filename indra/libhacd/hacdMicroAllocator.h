@@ -190,6 +190,11 @@ public:
 HeapManager * createHeapManager(NxU32 defaultChunkSize=32768);
 void          releaseHeapManager(HeapManager *heap);
 
+// hands out a heap manager for the exclusive use of one thread until it is given back with recycleHeapManager.
+// Recycled heap managers keep their chunks, so repeated decompositions reuse the same memory instead of going back to the system heap.
+HeapManager * acquireHeapManager(void);
+void          recycleHeapManager(HeapManager *heap);
+
 // about 10% faster than using the virtual interface, inlines the functions as much as possible.
 void * heap_malloc(HeapManager *hm,size_t size);
 void   heap_free(HeapManager *hm,void *p);
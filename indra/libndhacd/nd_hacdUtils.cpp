@@ -38,6 +38,7 @@ tHACD* init( int nConcavity, int nClusters, int nMaxVerticesPerHull, double dMax
 	pDec->SetNVerticesPerCH( nMaxVerticesPerHull );
 	pDec->SetConcavity( nConcavity );
 	pDec->SetConnectDist( dMaxConnectDist );
+	pDec->SetNThreads( 0 ); // One thread per core for the edge costs
 
 	pDec->SetCallBack( aData );
 
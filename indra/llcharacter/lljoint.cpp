@@ -50,6 +50,7 @@ void LLJoint::init()
 	mXform.setScale(LLVector3(1.0f, 1.0f, 1.0f));
 	mDirtyFlags = MATRIX_DIRTY | ROTATION_DIRTY | POSITION_DIRTY;
 	mUpdateXform = TRUE;
+	mUpdateListDirty = true;
 }
 
 LLJoint::LLJoint() :
@@ -187,6 +188,7 @@ void LLJoint::addChild(LLJoint* joint)
 	joint->mXform.setParent(&mXform);
 	joint->mParent = this;	
 	joint->touch();
+	invalidateUpdateList();
 }
 
 
@@ -203,6 +205,7 @@ void LLJoint::removeChild(LLJoint* joint)
 		joint->mXform.setParent(NULL);
 		joint->mParent = NULL;
 		joint->touch();
+		invalidateUpdateList();
 	}
 }
 
@@ -222,6 +225,43 @@ void LLJoint::removeAllChildren()
 		joint->mParent = NULL;
 		joint->touch();
 	}
+	invalidateUpdateList();
+}
+
+//--------------------------------------------------------------------
+// invalidateUpdateList()
+// The hierarchy below this joint changed; every ancestor that cached
+// a flattened update list now holds a stale one.
+//--------------------------------------------------------------------
+void LLJoint::invalidateUpdateList()
+{
+	for (LLJoint* joint = this; joint; joint = joint->mParent)
+	{
+		joint->mUpdateListDirty = true;
+	}
+}
+
+//--------------------------------------------------------------------
+// buildUpdateList()
+//--------------------------------------------------------------------
+void LLJoint::buildUpdateList()
+{
+	mUpdateList.clear();
+	appendToUpdateList(mUpdateList);
+	mUpdateListDirty = false;
+}
+
+void LLJoint::appendToUpdateList(update_list_t& list)
+{
+	U32 index = list.size();
+	UpdateEntry entry = { this, 0 };
+	list.push_back(entry);
+	for (child_list_t::iterator iter = mChildren.begin();
+		 iter != mChildren.end(); ++iter)
+	{
+		(*iter)->appendToUpdateList(list);
+	}
+	list[index].mSubtreeEnd = list.size();
 }
 
 
@@ -488,15 +528,29 @@ void LLJoint::updateWorldMatrixChildren()
 {	
 	if (!this->mUpdateXform) return;
 
-	if (mDirtyFlags & MATRIX_DIRTY)
+	if (mUpdateListDirty)
 	{
-		updateWorldMatrix();
+		buildUpdateList();
 	}
-	for (child_list_t::iterator iter = mChildren.begin();
-		 iter != mChildren.end(); ++iter)
+
+	// Parents precede their children in the list, so a single forward
+	// pass sees every parent's world transform before it is needed.
+	// Joints that don't update their xform are skipped with their subtree.
+	U32 count = mUpdateList.size();
+	for (U32 i = 0; i < count;)
 	{
-		LLJoint* joint = *iter;
-		joint->updateWorldMatrixChildren();
+		const UpdateEntry& entry = mUpdateList[i];
+		LLJoint* joint = entry.mJoint;
+		if (!joint->mUpdateXform)
+		{
+			i = entry.mSubtreeEnd;
+			continue;
+		}
+		if (joint->mDirtyFlags & MATRIX_DIRTY)
+		{
+			joint->updateWorldMatrix();
+		}
+		++i;
 	}
 }
 
@@ -31,6 +31,7 @@
 // Header Files
 //-----------------------------------------------------------------------------
 #include <string>
+#include <vector>
 
 #include "linked_lists.h"
 #include "v3math.h"
@@ -99,6 +100,24 @@ public:
 	typedef std::list<LLJoint*> child_list_t;
 	child_list_t mChildren;
 
+protected:
+	// Flattened copy of the subtree below this joint, parents before
+	// children, so updateWorldMatrixChildren() can walk it linearly.
+	// mSubtreeEnd is the index just past the entry's own descendants.
+	struct UpdateEntry
+	{
+		LLJoint*	mJoint;
+		U32			mSubtreeEnd;
+	};
+	typedef std::vector<UpdateEntry> update_list_t;
+	update_list_t	mUpdateList;
+	bool			mUpdateListDirty;
+
+	void invalidateUpdateList();
+	void buildUpdateList();
+	void appendToUpdateList(update_list_t& list);
+
+public:
 	// debug statics
 	static S32		sNumTouches;
 	static S32		sNumUpdates;
@@ -144,6 +144,38 @@ U32 LLKeyframeMotion::JointMotionList::dumpDiagInfo(bool silent) const
 //-----------------------------------------------------------------------------
 
 
+// Comparison functor to binary search the time-sorted keys of a curve.
+struct KeyTimeLess
+{
+	template<class KEY>
+	bool operator()(KEY const& key, F32 time) const { return key.mTime < time; }
+	template<class KEY>
+	bool operator()(F32 time, KEY const& key) const { return time < key.mTime; }
+	template<class KEY>
+	bool operator()(KEY const& key1, KEY const& key2) const { return key1.mTime < key2.mTime; }
+};
+
+// Insert key in keys, which is sorted by time, replacing any key with the same time.
+// The keys of an animation are normally stored in chronological order, in which case this just appends.
+template<class KEY>
+static void insert_key(std::vector<KEY>& keys, KEY const& key)
+{
+	if (keys.empty() || keys.back().mTime < key.mTime)
+	{
+		keys.push_back(key);
+		return;
+	}
+	typename std::vector<KEY>::iterator iter = std::lower_bound(keys.begin(), keys.end(), key.mTime, KeyTimeLess());
+	if (iter != keys.end() && iter->mTime == key.mTime)
+	{
+		*iter = key;
+	}
+	else
+	{
+		keys.insert(iter, key);
+	}
+}
+
 //-----------------------------------------------------------------------------
 // ScaleCurve::ScaleCurve()
 //-----------------------------------------------------------------------------
@@ -165,7 +197,7 @@ LLKeyframeMotion::ScaleCurve::~ScaleCurve()
 //-----------------------------------------------------------------------------
 // getValue()
 //-----------------------------------------------------------------------------
-LLVector3 LLKeyframeMotion::ScaleCurve::getValue(F32 time, F32 duration)
+LLVector3 LLKeyframeMotion::ScaleCurve::getValue(F32 time, F32 duration) const
 {
 	LLVector3 value;
 
@@ -175,34 +207,23 @@ LLVector3 LLKeyframeMotion::ScaleCurve::getValue(F32 time, F32 duration)
 		return value;
 	}
 	
-	key_map_t::iterator right = mKeys.lower_bound(time);
+	key_vector_t::const_iterator right = std::lower_bound(mKeys.begin(), mKeys.end(), time, KeyTimeLess());
 	if (right == mKeys.end())
 	{
 		// Past last key
-		--right;
-		value = right->second.mScale;
+		value = mKeys.back().mScale;
 	}
-	else if (right == mKeys.begin() || right->first == time)
+	else if (right == mKeys.begin() || right->mTime == time)
 	{
 		// Before first key or exactly on a key
-		value = right->second.mScale;
+		value = right->mScale;
 	}
 	else
 	{
 		// Between two keys
-		key_map_t::iterator left = right; --left;
-		F32 index_before = left->first;
-		F32 index_after = right->first;
-		ScaleKey& scale_before = left->second;
-		ScaleKey& scale_after = right->second;
-		if (right == mKeys.end())
-		{
-			scale_after = mLoopInKey;
-			index_after = duration;
-		}
-
-		F32 u = (time - index_before) / (index_after - index_before);
-		value = interp(u, scale_before, scale_after);
+		key_vector_t::const_iterator left = right - 1;
+		F32 u = (time - left->mTime) / (right->mTime - left->mTime);
+		value = interp(u, *left, *right);
 	}
 	return value;
 }
@@ -210,7 +231,7 @@ LLVector3 LLKeyframeMotion::ScaleCurve::getValue(F32 time, F32 duration)
 //-----------------------------------------------------------------------------
 // interp()
 //-----------------------------------------------------------------------------
-LLVector3 LLKeyframeMotion::ScaleCurve::interp(F32 u, ScaleKey& before, ScaleKey& after)
+LLVector3 LLKeyframeMotion::ScaleCurve::interp(F32 u, ScaleKey const& before, ScaleKey const& after) const
 {
 	switch (mInterpolationType)
 	{
@@ -245,7 +266,7 @@ LLKeyframeMotion::RotationCurve::~RotationCurve()
 //-----------------------------------------------------------------------------
 // RotationCurve::getValue()
 //-----------------------------------------------------------------------------
-LLQuaternion LLKeyframeMotion::RotationCurve::getValue(F32 time, F32 duration)
+LLQuaternion LLKeyframeMotion::RotationCurve::getValue(F32 time, F32 duration) const
 {
 	LLQuaternion value;
 
@@ -255,34 +276,23 @@ LLQuaternion LLKeyframeMotion::RotationCurve::getValue(F32 time, F32 duration)
 		return value;
 	}
 	
-	key_map_t::iterator right = mKeys.lower_bound(time);
+	key_vector_t::const_iterator right = std::lower_bound(mKeys.begin(), mKeys.end(), time, KeyTimeLess());
 	if (right == mKeys.end())
 	{
 		// Past last key
-		--right;
-		value = right->second.mRotation;
+		value = mKeys.back().mRotation;
 	}
-	else if (right == mKeys.begin() || right->first == time)
+	else if (right == mKeys.begin() || right->mTime == time)
 	{
 		// Before first key or exactly on a key
-		value = right->second.mRotation;
+		value = right->mRotation;
 	}
 	else
 	{
 		// Between two keys
-		key_map_t::iterator left = right; --left;
-		F32 index_before = left->first;
-		F32 index_after = right->first;
-		RotationKey& rot_before = left->second;
-		RotationKey& rot_after = right->second;
-		if (right == mKeys.end())
-		{
-			rot_after = mLoopInKey;
-			index_after = duration;
-		}
-
-		F32 u = (time - index_before) / (index_after - index_before);
-		value = interp(u, rot_before, rot_after);
+		key_vector_t::const_iterator left = right - 1;
+		F32 u = (time - left->mTime) / (right->mTime - left->mTime);
+		value = interp(u, *left, *right);
 	}
 	return value;
 }
@@ -290,7 +300,7 @@ LLQuaternion LLKeyframeMotion::RotationCurve::getValue(F32 time, F32 duration)
 //-----------------------------------------------------------------------------
 // interp()
 //-----------------------------------------------------------------------------
-LLQuaternion LLKeyframeMotion::RotationCurve::interp(F32 u, RotationKey& before, RotationKey& after)
+LLQuaternion LLKeyframeMotion::RotationCurve::interp(F32 u, RotationKey const& before, RotationKey const& after) const
 {
 	switch (mInterpolationType)
 	{
@@ -326,7 +336,7 @@ LLKeyframeMotion::PositionCurve::~PositionCurve()
 //-----------------------------------------------------------------------------
 // PositionCurve::getValue()
 //-----------------------------------------------------------------------------
-LLVector3 LLKeyframeMotion::PositionCurve::getValue(F32 time, F32 duration)
+LLVector3 LLKeyframeMotion::PositionCurve::getValue(F32 time, F32 duration) const
 {
 	LLVector3 value;
 
@@ -336,34 +346,23 @@ LLVector3 LLKeyframeMotion::PositionCurve::getValue(F32 time, F32 duration)
 		return value;
 	}
 	
-	key_map_t::iterator right = mKeys.lower_bound(time);
+	key_vector_t::const_iterator right = std::lower_bound(mKeys.begin(), mKeys.end(), time, KeyTimeLess());
 	if (right == mKeys.end())
 	{
 		// Past last key
-		--right;
-		value = right->second.mPosition;
+		value = mKeys.back().mPosition;
 	}
-	else if (right == mKeys.begin() || right->first == time)
+	else if (right == mKeys.begin() || right->mTime == time)
 	{
 		// Before first key or exactly on a key
-		value = right->second.mPosition;
+		value = right->mPosition;
 	}
 	else
 	{
 		// Between two keys
-		key_map_t::iterator left = right; --left;
-		F32 index_before = left->first;
-		F32 index_after = right->first;
-		PositionKey& pos_before = left->second;
-		PositionKey& pos_after = right->second;
-		if (right == mKeys.end())
-		{
-			pos_after = mLoopInKey;
-			index_after = duration;
-		}
-
-		F32 u = (time - index_before) / (index_after - index_before);
-		value = interp(u, pos_before, pos_after);
+		key_vector_t::const_iterator left = right - 1;
+		F32 u = (time - left->mTime) / (right->mTime - left->mTime);
+		value = interp(u, *left, *right);
 	}
 
 	llassert(value.isFinite());
@@ -374,7 +373,7 @@ LLVector3 LLKeyframeMotion::PositionCurve::getValue(F32 time, F32 duration)
 //-----------------------------------------------------------------------------
 // interp()
 //-----------------------------------------------------------------------------
-LLVector3 LLKeyframeMotion::PositionCurve::interp(F32 u, PositionKey& before, PositionKey& after)
+LLVector3 LLKeyframeMotion::PositionCurve::interp(F32 u, PositionKey const& before, PositionKey const& after) const
 {
 	switch (mInterpolationType)
 	{
@@ -1670,7 +1669,7 @@ BOOL LLKeyframeMotion::deserialize(LLDataPacker& dp)
 				return FALSE;
 			}
 
-			rCurve->mKeys[time] = rot_key;
+			insert_key(rCurve->mKeys, rot_key);
 		}
 
 		//---------------------------------------------------------------------
@@ -1749,7 +1748,7 @@ BOOL LLKeyframeMotion::deserialize(LLDataPacker& dp)
 				return FALSE;
 			}
 			
-			pCurve->mKeys[pos_key.mTime] = pos_key;
+			insert_key(pCurve->mKeys, pos_key);
 
 			if (is_pelvis)
 			{
@@ -2022,10 +2021,10 @@ BOOL LLKeyframeMotion::serialize(LLDataPacker& dp) const
 		success &= dp.packS32(joint_motionp->mPriority, "joint_priority");
 		success &= dp.packS32(joint_motionp->mRotationCurve.mNumKeys, "num_rot_keys");
 
-		for (RotationCurve::key_map_t::iterator iter = joint_motionp->mRotationCurve.mKeys.begin();
+		for (RotationCurve::key_vector_t::iterator iter = joint_motionp->mRotationCurve.mKeys.begin();
 			 iter != joint_motionp->mRotationCurve.mKeys.end(); ++iter)
 		{
-			RotationKey& rot_key = iter->second;
+			RotationKey& rot_key = *iter;
 			U16 time_short = F32_to_U16(rot_key.mTime, 0.f, mJointMotionList->mDuration);
 			success &= dp.packU16(time_short, "time");
 
@@ -2042,10 +2041,10 @@ BOOL LLKeyframeMotion::serialize(LLDataPacker& dp) const
 		}
 
 		success &= dp.packS32(joint_motionp->mPositionCurve.mNumKeys, "num_pos_keys");
-		for (PositionCurve::key_map_t::iterator iter = joint_motionp->mPositionCurve.mKeys.begin();
+		for (PositionCurve::key_vector_t::iterator iter = joint_motionp->mPositionCurve.mKeys.begin();
 			 iter != joint_motionp->mPositionCurve.mKeys.end(); ++iter)
 		{
-			PositionKey& pos_key = iter->second;
+			PositionKey& pos_key = *iter;
 			U16 time_short = F32_to_U16(pos_key.mTime, 0.f, mJointMotionList->mDuration);
 			success &= dp.packU16(time_short, "time");
 
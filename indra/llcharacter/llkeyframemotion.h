@@ -39,6 +39,7 @@
 //-----------------------------------------------------------------------------
 
 #include <string>
+#include <vector>
 
 #include "llassetstorage.h"
 #include "llbboxlocal.h"
@@ -434,13 +435,13 @@ public:
 	public:
 		ScaleCurve();
 		~ScaleCurve();
-		LLVector3 getValue(F32 time, F32 duration);
-		LLVector3 interp(F32 u, ScaleKey& before, ScaleKey& after);
+		LLVector3 getValue(F32 time, F32 duration) const;
+		LLVector3 interp(F32 u, ScaleKey const& before, ScaleKey const& after) const;
 
 		InterpolationType	mInterpolationType;
 		S32					mNumKeys;
-		typedef std::map<F32, ScaleKey> key_map_t;
-		key_map_t 			mKeys;
+		typedef std::vector<ScaleKey> key_vector_t;
+		key_vector_t		mKeys;			// Sorted by mTime, unique times.
 		ScaleKey			mLoopInKey;
 		ScaleKey			mLoopOutKey;
 	};
@@ -453,13 +454,13 @@ public:
 	public:
 		RotationCurve();
 		~RotationCurve();
-		LLQuaternion getValue(F32 time, F32 duration);
-		LLQuaternion interp(F32 u, RotationKey& before, RotationKey& after);
+		LLQuaternion getValue(F32 time, F32 duration) const;
+		LLQuaternion interp(F32 u, RotationKey const& before, RotationKey const& after) const;
 
 		InterpolationType	mInterpolationType;
 		S32					mNumKeys;
-		typedef std::map<F32, RotationKey> key_map_t;
-		key_map_t		mKeys;
+		typedef std::vector<RotationKey> key_vector_t;
+		key_vector_t		mKeys;			// Sorted by mTime, unique times.
 		RotationKey		mLoopInKey;
 		RotationKey		mLoopOutKey;
 	};
@@ -472,13 +473,13 @@ public:
 	public:
 		PositionCurve();
 		~PositionCurve();
-		LLVector3 getValue(F32 time, F32 duration);
-		LLVector3 interp(F32 u, PositionKey& before, PositionKey& after);
+		LLVector3 getValue(F32 time, F32 duration) const;
+		LLVector3 interp(F32 u, PositionKey const& before, PositionKey const& after) const;
 
 		InterpolationType	mInterpolationType;
 		S32					mNumKeys;
-		typedef std::map<F32, PositionKey> key_map_t;
-		key_map_t		mKeys;
+		typedef std::vector<PositionKey> key_vector_t;
+		key_vector_t		mKeys;			// Sorted by mTime, unique times.
 		PositionKey		mLoopInKey;
 		PositionKey		mLoopOutKey;
 	};
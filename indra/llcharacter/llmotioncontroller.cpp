@@ -529,7 +529,7 @@ void LLMotionController::updateIdleMotion(LLMotion* motionp)
 {
 	if (motionp->isStopped() && mAnimTime > motionp->getStopTime() + motionp->getEaseOutDuration())
 	{
-		deactivateMotionInstance(motionp);
+		deactivateMotionInstanceDeferred(motionp);
 	}
 	else if (motionp->isStopped() && mAnimTime > motionp->getStopTime())
 	{
@@ -546,8 +546,7 @@ void LLMotionController::updateIdleMotion(LLMotion* motionp)
 		// this will only be called when an animation stops itself (runs out of time)
 		if (mLastTime <= motionp->mSendStopTimestamp)
 		{
-			mCharacter->requestStopMotion( motionp );
-			stopMotionInstance(motionp, FALSE);
+			requestStopMotionDeferred(motionp);
 		}
 	}
 	else if (mAnimTime >= motionp->mActivationTimestamp)
@@ -572,6 +571,7 @@ void LLMotionController::updateIdleActiveMotions()
 		LLMotion* motionp = *curiter;
 		updateIdleMotion(motionp);
 	}
+	flushDeferredMotionActions();
 }
 
 //-----------------------------------------------------------------------------
@@ -649,8 +649,7 @@ void LLMotionController::updateMotionsByType(LLMotion::LLMotionBlendType anim_ty
 				// this will only be called when an animation stops itself (runs out of time)
 				if (mLastTime <= motionp->mSendStopTimestamp)
 				{
-					mCharacter->requestStopMotion( motionp );
-					stopMotionInstance(motionp, FALSE);
+					requestStopMotionDeferred(motionp);
 				}
 			}
 
@@ -659,7 +658,7 @@ void LLMotionController::updateMotionsByType(LLMotion::LLMotionBlendType anim_ty
 				if (motionp->isStopped() && mAnimTime > motionp->getStopTime() + motionp->getEaseOutDuration())
 				{
 					posep->setWeight(0.f);
-					deactivateMotionInstance(motionp);
+					deactivateMotionInstanceDeferred(motionp);
 				}
 				continue;
 			}
@@ -686,7 +685,7 @@ void LLMotionController::updateMotionsByType(LLMotion::LLMotionBlendType anim_ty
 			else
 			{
 				posep->setWeight(0.f);
-				deactivateMotionInstance(motionp);
+				deactivateMotionInstanceDeferred(motionp);
 				continue;
 			}
 		}
@@ -730,8 +729,7 @@ void LLMotionController::updateMotionsByType(LLMotion::LLMotionBlendType anim_ty
 				// this will only be called when an animation stops itself (runs out of time)
 				if (mLastTime <= motionp->mSendStopTimestamp)
 				{
-					mCharacter->requestStopMotion( motionp );
-					stopMotionInstance(motionp, FALSE);
+					requestStopMotionDeferred(motionp);
 				}
 			}
 
@@ -777,8 +775,7 @@ void LLMotionController::updateMotionsByType(LLMotion::LLMotionBlendType anim_ty
 				// animation has stopped itself due to internal logic
 				// propagate this to the network
 				// as not all viewers are guaranteed to have access to the same logic
-				mCharacter->requestStopMotion( motionp );
-				stopMotionInstance(motionp, FALSE);
+				requestStopMotionDeferred(motionp);
 			}
 
 		}
@@ -786,6 +783,60 @@ void LLMotionController::updateMotionsByType(LLMotion::LLMotionBlendType anim_ty
 		// even if onupdate returns FALSE, add this motion in to the blend one last time
 		mPoseBlender.addMotion(motionp);
 	}
+
+	flushDeferredMotionActions();
+}
+
+//-----------------------------------------------------------------------------
+// requestStopMotionDeferred()
+// Stop motionp now, but postpone notifying the character till flushDeferredMotionActions().
+//-----------------------------------------------------------------------------
+void LLMotionController::requestStopMotionDeferred(LLMotion* motionp)
+{
+	mDeferredActions.push_back(std::make_pair(deferred_stop_request, motionp));
+	stopMotionInstance(motionp, FALSE);
+}
+
+//-----------------------------------------------------------------------------
+// deactivateMotionInstanceDeferred()
+// motionp must not be evaluated anymore; it is deactivated by flushDeferredMotionActions().
+//-----------------------------------------------------------------------------
+void LLMotionController::deactivateMotionInstanceDeferred(LLMotion* motionp)
+{
+	mDeferredActions.push_back(std::make_pair(deferred_deactivation, motionp));
+}
+
+//-----------------------------------------------------------------------------
+// flushDeferredMotionActions()
+//-----------------------------------------------------------------------------
+void LLMotionController::flushDeferredMotionActions()
+{
+	if (mDeferredActions.empty())
+	{
+		return;
+	}
+	// Swap, because requestStopMotion may cause us to be called recursively.
+	deferred_actions_t actions;
+	actions.swap(mDeferredActions);
+	for (deferred_actions_t::iterator iter = actions.begin(); iter != actions.end(); ++iter)
+	{
+		LLMotion* motionp = iter->second;
+		// Deactivating a deprecated motion deletes it, and a stop request might stop (and thus
+		// deactivate or delete) other motions. Every queued motion was active when it was queued,
+		// so skip the ones that aren't anymore.
+		if (std::find(mActiveMotions.begin(), mActiveMotions.end(), motionp) == mActiveMotions.end())
+		{
+			continue;
+		}
+		if (iter->first == deferred_stop_request)
+		{
+			mCharacter->requestStopMotion(motionp);
+		}
+		else
+		{
+			deactivateMotionInstance(motionp);
+		}
+	}
 }
 
 //-----------------------------------------------------------------------------
@@ -39,6 +39,7 @@
 #include <string>
 #include <map>
 #include <deque>
+#include <vector>
 
 #include "llmotion.h"
 #include "llpose.h"
@@ -206,6 +207,9 @@ protected:
 	void updateMotionsByType(LLMotion::LLMotionBlendType motion_type);
 	void updateIdleMotion(LLMotion* motionp);
 	void updateIdleActiveMotions();
+	void requestStopMotionDeferred(LLMotion* motionp);
+	void deactivateMotionInstanceDeferred(LLMotion* motionp);
+	void flushDeferredMotionActions();
 	void purgeExcessMotions();
 	void deactivateStoppedMotions();
 
@@ -255,6 +259,14 @@ protected:
 
 	U8					mJointSignature[2][LL_CHARACTER_MAX_JOINTS];
 
+	// Side effects of evaluating the active motions, that are postponed till all motions of one
+	// blend type have been evaluated: the evaluation itself then only touches the motions and
+	// their poses, while stop requests (which go to the network) and deactivations (which run
+	// callbacks) are done afterwards, in the order they were queued, by flushDeferredMotionActions().
+	enum deferred_action_type { deferred_stop_request, deferred_deactivation };
+	typedef std::vector<std::pair<deferred_action_type, LLMotion*> > deferred_actions_t;
+	deferred_actions_t	mDeferredActions;
+
 	//<singu>
 public:
 	// Internal administration for AISync.
@@ -0,0 +1,219 @@
+/**
+ * @file llahocorasick.h
+ * @brief Multiple pattern string matching: a trie with Aho-Corasick failure links.
+ *
+ * $LicenseInfo:firstyear=2013&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLAHOCORASICK_H
+#define LL_LLAHOCORASICK_H
+
+#include <algorithm>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "lldefs.h"
+#include "llerror.h"
+
+// A trie over a set of patterns, each tagged with a non-negative value.
+// Walking it with child() answers "does the text here start with a pattern"
+// a character at a time; once compile() has added the failure links, find()
+// locates patterns anywhere in a text in a single pass.
+//
+// Adding the same pattern again replaces its value.
+template <class CHAR>
+class LLAhoCorasick
+{
+public:
+	typedef U32 node_t;
+	static const node_t ROOT = 0;
+	static const node_t NO_NODE = 0xffffffff;
+
+	LLAhoCorasick()
+	{
+		clear();
+	}
+
+	void clear()
+	{
+		mNodes.clear();
+		mNodes.push_back(Node());
+		std::fill(mRootAscii, mRootAscii + 128, NO_NODE);
+		mCompiled = true;	// Nothing to link yet
+	}
+
+	bool empty() const { return mNodes.size() == 1 && mNodes[ROOT].mValue < 0; }
+
+	void add(const CHAR* pattern, size_t length, S32 value)
+	{
+		llassert(value >= 0);
+		node_t node = ROOT;
+		for (size_t i = 0; i < length; ++i)
+		{
+			node_t next = child(node, pattern[i]);
+			if (next == NO_NODE)
+			{
+				next = mNodes.size();
+				mNodes.push_back(Node());
+				std::vector<edge_t>& edges = mNodes[node].mEdges;
+				edge_t edge(pattern[i], next);
+				edges.insert(std::lower_bound(edges.begin(), edges.end(), edge), edge);
+				if (node == ROOT && (U32)pattern[i] < 128)
+				{
+					mRootAscii[(U32)pattern[i]] = next;
+				}
+			}
+			node = next;
+		}
+		mNodes[node].mValue = value;
+		mCompiled = false;
+	}
+
+	void add(const std::basic_string<CHAR>& pattern, S32 value)
+	{
+		add(pattern.data(), pattern.size(), value);
+	}
+
+	// The node reached from 'node' on 'c', or NO_NODE.
+	node_t child(node_t node, CHAR c) const
+	{
+		if (node == ROOT && (U32)c < 128)
+		{
+			return mRootAscii[(U32)c];
+		}
+		const std::vector<edge_t>& edges = mNodes[node].mEdges;
+		typename std::vector<edge_t>::const_iterator iter = std::lower_bound(edges.begin(), edges.end(), edge_t(c, 0));
+		return (iter != edges.end() && iter->first == c) ? iter->second : NO_NODE;
+	}
+
+	// Value of the pattern spelled by the path to 'node', or -1.
+	S32 value(node_t node) const { return mNodes[node].mValue; }
+
+	// Highest value among the patterns that [text, end) starts with, or -1.
+	S32 matchPrefix(const CHAR* text, const CHAR* end) const
+	{
+		S32 best = mNodes[ROOT].mValue;
+		node_t node = ROOT;
+		for (const CHAR* p = text; p != end; ++p)
+		{
+			node = child(node, *p);
+			if (node == NO_NODE)
+			{
+				break;
+			}
+			best = llmax(best, mNodes[node].mValue);
+		}
+		return best;
+	}
+
+	// Builds the failure links used by find().
+	void compile()
+	{
+		std::deque<node_t> queue;
+		mNodes[ROOT].mFail = ROOT;
+		mNodes[ROOT].mOutput = mNodes[ROOT].mValue;
+		queue.push_back(ROOT);
+		while (!queue.empty())
+		{
+			node_t node = queue.front();
+			queue.pop_front();
+			for (size_t i = 0; i < mNodes[node].mEdges.size(); ++i)
+			{
+				CHAR c = mNodes[node].mEdges[i].first;
+				node_t next = mNodes[node].mEdges[i].second;
+				node_t fail = ROOT;
+				if (node != ROOT)
+				{
+					fail = step(mNodes[node].mFail, c);
+				}
+				Node& next_node = mNodes[next];
+				next_node.mFail = fail;
+				next_node.mOutput = next_node.mValue >= 0 ? next_node.mValue : mNodes[fail].mOutput;
+				queue.push_back(next);
+			}
+		}
+		mCompiled = true;
+	}
+
+	// Finds the pattern occurrence in [text, end) that ends first, returning
+	// its value and setting *match_end past its last character. Returns -1
+	// when there is none.
+	S32 find(const CHAR* text, const CHAR* end, const CHAR** match_end = NULL) const
+	{
+		llassert(mCompiled);
+		node_t node = ROOT;
+		const CHAR* p = text;
+		while (mNodes[node].mOutput < 0)
+		{
+			if (p == end)
+			{
+				return -1;
+			}
+			node = step(node, *p++);
+		}
+		if (match_end)
+		{
+			*match_end = p;
+		}
+		return mNodes[node].mOutput;
+	}
+
+private:
+	// Goto function extended with the failure links.
+	node_t step(node_t node, CHAR c) const
+	{
+		while (true)
+		{
+			node_t next = child(node, c);
+			if (next != NO_NODE)
+			{
+				return next;
+			}
+			if (node == ROOT)
+			{
+				return ROOT;
+			}
+			node = mNodes[node].mFail;
+		}
+	}
+
+	typedef std::pair<CHAR, node_t> edge_t;
+
+	struct Node
+	{
+		Node() : mFail(ROOT), mValue(-1), mOutput(-1) { }
+		std::vector<edge_t> mEdges;		// Sorted on character
+		node_t mFail;
+		S32 mValue;
+		S32 mOutput;					// mValue, or the output of mFail
+	};
+
+	std::vector<Node> mNodes;
+	node_t mRootAscii[128];				// Children of the root, for the common case
+	bool mCompiled;
+};
+
+template <class CHAR>
+const typename LLAhoCorasick<CHAR>::node_t LLAhoCorasick<CHAR>::ROOT;
+template <class CHAR>
+const typename LLAhoCorasick<CHAR>::node_t LLAhoCorasick<CHAR>::NO_NODE;
+
+#endif // LL_LLAHOCORASICK_H
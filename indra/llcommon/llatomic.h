@@ -100,4 +100,32 @@ private:
 typedef LLAtomic32<U32> LLAtomicU32;
 typedef LLAtomic32<S32> LLAtomicS32;
 
+// Atomic pointer, for publishing objects to lock-free readers.
+// Both assignment and read are sequentially consistent.
+template <typename Type> class LLAtomicPtr
+{
+public:
+#if defined(NEEDS_APR_ATOMICS)
+	LLAtomicPtr(Type* x = NULL) : mData(x) { }
+
+	operator Type*() const { return static_cast<Type*>(apr_atomic_casptr(const_cast<volatile void**>(&mData), NULL, NULL)); }
+	void operator=(Type* x) { apr_atomic_xchgptr(&mData, x); }
+
+private:
+	volatile void* mData;
+#else
+	LLAtomicPtr(Type* x = NULL) : mData(x) { }
+
+	operator Type*() const { return mData; }
+	void operator=(Type* x) { mData = x; }
+
+private:
+	typename impl_atomic_type<Type*>::type mData;
+#endif
+
+	// Not copyable.
+	LLAtomicPtr(LLAtomicPtr const&);
+	LLAtomicPtr& operator=(LLAtomicPtr const&);
+};
+
 #endif
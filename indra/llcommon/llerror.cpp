@@ -40,6 +40,7 @@
 # include <unistd.h>
 #endif // !LL_WINDOWS
 #include <vector>
+#include <deque>
 #include <cstring>
 
 #include "llapp.h"
@@ -940,8 +941,176 @@ namespace {
 	}
 }
 
+namespace {
+	// Background writer used by LLError::startAsyncLogging.
+	class AsyncLogThread : public LLThread
+	{
+	public:
+		AsyncLogThread(U32 queue_size, LLError::EAsyncDropPolicy policy);
+
+		// Called with gLogMutex locked. Returns false if the message must be
+		// written by the caller.
+		bool push(const LLError::CallSite& site, std::string& message);
+		// Write out everything that is queued, on the calling thread, after
+		// whatever the log thread is writing right now.
+		void drain();
+		// Let the thread write out everything that is queued and wait till it exited.
+		void stop();
+
+		U32 getDropped() const { return mDropped; }
+
+	protected:
+		/*virtual*/ void run();
+		/*virtual*/ void terminated();
+
+	private:
+		struct Record
+		{
+			const LLError::CallSite* mSite;
+			std::string mMessage;
+		};
+		typedef std::deque<Record> queue_t;
+
+		void write(queue_t& batch);
+		void reportDropped();
+
+		LLCondition mQueueCondition;		// Protects the members below.
+		queue_t mQueue;
+		bool mStopping;
+		U32 const mQueueSize;
+		LLError::EAsyncDropPolicy const mPolicy;
+		LLAtomicU32 mDropped;
+		LLMutex mWriteMutex;				// Held from taking a batch off the queue till it is written.
+		U32 mReportedDropped;				// Protected by mWriteMutex.
+	};
+
+	// Protected by gLogMutex.
+	AsyncLogThread* sAsyncLog;
+}
+
 namespace LLError
 {
+	// Format a message for its call site and pass it to all recorders.
+	// Called by Log::flush, or by the async log thread.
+	void Log::writeMessage(const CallSite& site, std::string& message)
+	{
+		AIAccess<Settings> settings_w(Settings::get());
+
+		if (site.mLevel == LEVEL_ERROR)
+		{
+			std::ostringstream fatalMessage;
+			fatalMessage << abbreviateFile(site.mFile)
+						<< "(" << site.mLine << ") : error";
+			
+			writeToRecorders(settings_w, site.mLevel, fatalMessage.str());
+		}
+		
+		
+		std::ostringstream prefix;
+
+		switch (site.mLevel)
+		{
+			case LEVEL_DEBUG:		prefix << "DEBUG";	break;
+			case LEVEL_INFO:		prefix << "INFO";		break;
+			case LEVEL_WARN:		prefix << "WARNING";	break;
+			case LEVEL_ERROR:		prefix << "ERROR";	break;
+			default:				prefix << "XXX";		break;
+		};
+
+		bool need_function = site.mFunction;
+		if (need_function && site.mBroadTag && *site.mBroadTag != '\0')
+		{
+			prefix << "(\"" << site.mBroadTag << "\")";
+#if LL_DEBUG
+			// Suppress printing mFunction if mBroadTag is set, starts with
+			// "Plugin " and ends with "child": a debug message from a plugin.
+			size_t taglen = strlen(site.mBroadTag);
+			if (taglen >= 12 && strncmp(site.mBroadTag, "Plugin ", 7) == 0 &&
+				strcmp(site.mBroadTag + taglen - 5, "child") == 0)
+			{
+				need_function = false;
+			}
+#endif
+		}
+
+		prefix << ": ";
+		
+		if (need_function)
+		{
+			if (settings_w->printLocation)
+			{
+				prefix << abbreviateFile(site.mFile)
+						<< "(" << site.mLine << ") : ";
+			}
+			
+#if LL_WINDOWS
+			// DevStudio: __FUNCTION__ already includes the full class name
+#else
+			if (site.mClassInfo != typeid(NoClassInfo))
+			{
+				prefix << className(site.mClassInfo) << "::";
+			}
+#endif
+			prefix << site.mFunction << ": ";
+		}
+
+		if (site.mPrintOnce)
+		{
+			std::map<std::string, unsigned int>::iterator messageIter = settings_w->uniqueLogMessages.find(message);
+			if (messageIter != settings_w->uniqueLogMessages.end())
+			{
+				messageIter->second++;
+				unsigned int num_messages = messageIter->second;
+				if (num_messages == 10 || num_messages == 50 || (num_messages % 100) == 0)
+				{
+					prefix << "ONCE (" << num_messages << "th time seen): ";
+				} 
+				else
+				{
+					return;
+				}
+			}
+			else 
+			{
+				prefix << "ONCE: ";
+				settings_w->uniqueLogMessages[message] = 1;
+			}
+		}
+
+		if (site.mPrintOnce)
+		{
+			std::map<std::string, unsigned int>::iterator messageIter = settings_w->uniqueLogMessages.find(message);
+			if (messageIter != settings_w->uniqueLogMessages.end())
+			{
+				messageIter->second++;
+				unsigned int num_messages = messageIter->second;
+				if (num_messages == 10 || num_messages == 50 || (num_messages % 100) == 0)
+				{
+					prefix << "ONCE (" << num_messages << "th time seen): ";
+				} 
+				else
+				{
+					return;
+				}
+			}
+			else 
+			{
+				prefix << "ONCE: ";
+				settings_w->uniqueLogMessages[message] = 1;
+			}
+		}
+		
+		prefix << message;
+		message = prefix.str();
+		
+		writeToRecorders(settings_w, site.mLevel, message);
+		
+		if (site.mLevel == LEVEL_ERROR  &&  settings_w->crashFunction)
+		{
+			settings_w->crashFunction(message);
+		}
+	}
+
 	bool Log::shouldLog(CallSite& site)
 	{
 		LogLock lock;
@@ -1056,126 +1225,177 @@ namespace LLError
 			}
 		}
 
-		AIAccess<Settings> settings_w(Settings::get());
-
-		if (site.mLevel == LEVEL_ERROR)
+		if (site.mLevel != LEVEL_ERROR && sAsyncLog && sAsyncLog->push(site, message))
 		{
-			std::ostringstream fatalMessage;
-			fatalMessage << abbreviateFile(site.mFile)
-						<< "(" << site.mLine << ") : error";
-			
-			writeToRecorders(settings_w, site.mLevel, fatalMessage.str());
+			return;
 		}
-		
-		
-		std::ostringstream prefix;
-
-		switch (site.mLevel)
+		if (sAsyncLog)
 		{
-			case LEVEL_DEBUG:		prefix << "DEBUG";	break;
-			case LEVEL_INFO:		prefix << "INFO";		break;
-			case LEVEL_WARN:		prefix << "WARNING";	break;
-			case LEVEL_ERROR:		prefix << "ERROR";	break;
-			default:				prefix << "XXX";		break;
-		};
+			// Get everything that was queued before this out first,
+			// the crash function may never return.
+			sAsyncLog->drain();
+		}
+		Log::writeMessage(site, message);
+	}
+}
 
-		bool need_function = site.mFunction;
-		if (need_function && site.mBroadTag && *site.mBroadTag != '\0')
+namespace {
+	AsyncLogThread::AsyncLogThread(U32 queue_size, LLError::EAsyncDropPolicy policy)
+	:	LLThread("Log"),
+		mStopping(false),
+		mQueueSize(queue_size),
+		mPolicy(policy),
+		mDropped(0),
+		mReportedDropped(0)
+	{
+	}
+
+	bool AsyncLogThread::push(const LLError::CallSite& site, std::string& message)
+	{
+		LLMutexLock lock(mQueueCondition);
+		if (mQueue.size() >= mQueueSize)
 		{
-			prefix << "(\"" << site.mBroadTag << "\")";
-#if LL_DEBUG
-			// Suppress printing mFunction if mBroadTag is set, starts with
-			// "Plugin " and ends with "child": a debug message from a plugin.
-			size_t taglen = strlen(site.mBroadTag);
-			if (taglen >= 12 && strncmp(site.mBroadTag, "Plugin ", 7) == 0 &&
-				strcmp(site.mBroadTag + taglen - 5, "child") == 0)
+			switch (mPolicy)
 			{
-				need_function = false;
+				case LLError::ASYNC_DROP_NEWEST:
+					mDropped++;
+					return true;
+				case LLError::ASYNC_DROP_OLDEST:
+					mDropped++;
+					mQueue.pop_front();
+					break;
+				default:
+					return false;
 			}
-#endif
 		}
+		mQueue.push_back(Record());
+		mQueue.back().mSite = &site;
+		mQueue.back().mMessage.swap(message);
+		mQueueCondition.signal();
+		return true;
+	}
 
-		prefix << ": ";
-		
-		if (need_function)
+	void AsyncLogThread::drain()
+	{
+		// A fatal error while the log thread itself is writing: what it took off the queue
+		// is being written out already, and the rest must wait.
+		if (mWriteMutex.isSelfLocked())
 		{
-			if (settings_w->printLocation)
-			{
-				prefix << abbreviateFile(site.mFile)
-						<< "(" << site.mLine << ") : ";
-			}
-			
-#if LL_WINDOWS
-			// DevStudio: __FUNCTION__ already includes the full class name
-#else
-			if (site.mClassInfo != typeid(NoClassInfo))
-			{
-				prefix << className(site.mClassInfo) << "::";
-			}
-#endif
-			prefix << site.mFunction << ": ";
+			return;
 		}
+		LLMutexLock write_lock(mWriteMutex);
+		queue_t batch;
+		{
+			LLMutexLock lock(mQueueCondition);
+			batch.swap(mQueue);
+		}
+		write(batch);
+	}
 
-		if (site.mPrintOnce)
+	void AsyncLogThread::stop()
+	{
 		{
-			std::map<std::string, unsigned int>::iterator messageIter = settings_w->uniqueLogMessages.find(message);
-			if (messageIter != settings_w->uniqueLogMessages.end())
-			{
-				messageIter->second++;
-				unsigned int num_messages = messageIter->second;
-				if (num_messages == 10 || num_messages == 50 || (num_messages % 100) == 0)
-				{
-					prefix << "ONCE (" << num_messages << "th time seen): ";
-				} 
-				else
-				{
-					return;
-				}
-			}
-			else 
+			LLMutexLock lock(mQueueCondition);
+			mStopping = true;
+			mQueueCondition.broadcast();
+			// Wait till the thread wrote everything and signalled us from terminated().
+			while (!isStopped())
 			{
-				prefix << "ONCE: ";
-				settings_w->uniqueLogMessages[message] = 1;
+				mQueueCondition.wait();
 			}
 		}
+		drain();
+	}
 
-		if (site.mPrintOnce)
+	void AsyncLogThread::run()
+	{
+		queue_t batch;
+		while (true)
 		{
-			std::map<std::string, unsigned int>::iterator messageIter = settings_w->uniqueLogMessages.find(message);
-			if (messageIter != settings_w->uniqueLogMessages.end())
+			mQueueCondition.lock();
+			while (mQueue.empty() && !mStopping)
 			{
-				messageIter->second++;
-				unsigned int num_messages = messageIter->second;
-				if (num_messages == 10 || num_messages == 50 || (num_messages % 100) == 0)
-				{
-					prefix << "ONCE (" << num_messages << "th time seen): ";
-				} 
-				else
-				{
-					return;
-				}
+				mQueueCondition.wait();
 			}
-			else 
+			bool const done = mQueue.empty();
+			mQueueCondition.unlock();
+			if (done)
 			{
-				prefix << "ONCE: ";
-				settings_w->uniqueLogMessages[message] = 1;
+				break;
+			}
+
+			LLMutexLock write_lock(mWriteMutex);
+			{
+				LLMutexLock lock(mQueueCondition);
+				batch.swap(mQueue);
 			}
+			write(batch);
+			batch.clear();
 		}
-		
-		prefix << message;
-		message = prefix.str();
-		
-		writeToRecorders(settings_w, site.mLevel, message);
-		
-		if (site.mLevel == LEVEL_ERROR  &&  settings_w->crashFunction)
+	}
+
+	void AsyncLogThread::terminated()
+	{
+		// This is the last time that the thread touches this object: stop() deletes it as soon as it wakes up.
+		LLMutexLock lock(mQueueCondition);
+		LLThread::terminated();
+		mQueueCondition.broadcast();
+	}
+
+	void AsyncLogThread::write(queue_t& batch)
+	{
+		for (queue_t::iterator record = batch.begin(); record != batch.end(); ++record)
 		{
-			settings_w->crashFunction(message);
+			LLError::Log::writeMessage(*record->mSite, record->mMessage);
+		}
+		reportDropped();
+	}
+
+	void AsyncLogThread::reportDropped()
+	{
+		U32 dropped = mDropped;
+		if (dropped != mReportedDropped)
+		{
+			std::ostringstream message;
+			message << "WARNING: " << (dropped - mReportedDropped) << " log messages were dropped (log queue full).";
+			mReportedDropped = dropped;
+			writeToRecorders(AIAccess<LLError::Settings>(LLError::Settings::get()), LLError::LEVEL_WARN, message.str());
 		}
 	}
 }
 
+namespace LLError
+{
+	void startAsyncLogging(U32 queue_size, EAsyncDropPolicy policy)
+	{
+		stopAsyncLogging();
+		AsyncLogThread* thread = new AsyncLogThread(llmax(queue_size, (U32)1), policy);
+		thread->start();
+		LogLock lock;
+		sAsyncLog = thread;
+	}
 
+	void stopAsyncLogging()
+	{
+		AsyncLogThread* thread;
+		{
+			LogLock lock;
+			thread = sAsyncLog;
+			sAsyncLog = NULL;
+		}
+		if (thread)
+		{
+			thread->stop();
+			delete thread;
+		}
+	}
 
+	U32 getDroppedLogMessages()
+	{
+		LogLock lock;
+		return sAsyncLog ? sAsyncLog->getDropped() : 0;
+	}
+}
 
 namespace LLError
 {
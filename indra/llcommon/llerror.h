@@ -131,6 +131,8 @@ namespace LLError
 		static std::ostringstream* out();
 		static void flush(std::ostringstream* out, char* message)  ;
 		static void flush(std::ostringstream*, const CallSite&);
+		// Formats and records a flushed message; used directly by the async log thread.
+		static void writeMessage(const CallSite&, std::string& message);
 	};
 	
 	class LL_COMMON_API CallSite
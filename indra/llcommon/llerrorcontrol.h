@@ -165,6 +165,22 @@ namespace LLError
 	LL_COMMON_API std::string logFileName();
 		// returns name of current logging file, empty string if none
 
+	enum EAsyncDropPolicy
+	{
+		ASYNC_DROP_NEWEST,		// discard the message being logged
+		ASYNC_DROP_OLDEST,		// discard the oldest queued message
+		ASYNC_WRITE_THROUGH		// write it from the calling thread instead
+	};
+
+	LL_COMMON_API void startAsyncLogging(U32 queue_size, EAsyncDropPolicy policy);
+	LL_COMMON_API void stopAsyncLogging();
+		// While started, messages other than errors are queued and formatted
+		// and written by a background thread. The policy decides what happens
+		// when more than queue_size messages are waiting. Stopping writes out
+		// whatever is still queued. Must be stopped before APR is terminated.
+	LL_COMMON_API U32 getDroppedLogMessages();
+		// number of messages discarded by the drop policy so far
+
 
 	/*
 		Utilities for use by the unit tests of LLError itself.
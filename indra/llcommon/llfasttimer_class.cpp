@@ -141,6 +141,12 @@
 //
 // I fixed updateCachedPointers() to correct all of the above pointers and removed
 // another FrameState pointer that was unnecessary.
+//
+// Other threads use LLFastTimer::ThreadTimer instead. Those keep their own
+// stack per thread (in a ThreadTimerData hung off LLThreadLocalData) and
+// queue every finished call; collectThreadTimers(), called by nextFrame(),
+// adds the queued self times to the FrameState of the timer and parents
+// timers that are still directly below the root under their caller.
 
 #include "linden_common.h"
 
@@ -151,8 +157,12 @@
 #include "llsingleton.h"
 #include "lltreeiterators.h"
 #include "llsdserialize.h"
+#include "llthread.h"
+#include "aithreadsafe.h"
 
 #include <boost/bind.hpp>
+#include <algorithm>
+#include <map>
 
 
 #if LL_WINDOWS
@@ -182,6 +192,7 @@ std::string LLFastTimer::sLogName = "";
 BOOL LLFastTimer::sMetricLog = FALSE;
 LLMutex* LLFastTimer::sLogLock = NULL;
 std::queue<LLSD> LLFastTimer::sLogQueue;
+bool LLFastTimer::sTrace = false;
 const int LLFastTimer::NamedTimer::HISTORY_NUM = 300;
 
 #if defined(LL_WINDOWS) && !defined(_WIN64)
@@ -844,6 +855,229 @@ std::vector<LLFastTimer::NamedTimer*>& LLFastTimer::NamedTimer::getChildren()
 	return mChildren;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+// Timers in other threads
+
+namespace
+{
+	struct ThreadTimerEvent
+	{
+		LLFastTimer::NamedTimer*	mTimer;
+		LLFastTimer::NamedTimer*	mCaller;
+		U32							mStartTime;
+		U32							mDuration;
+		U32							mSelfTime;
+	};
+	typedef std::vector<ThreadTimerEvent> thread_timer_event_list_t;
+
+	// Drop events when the main thread isn't collecting them.
+	const size_t MAX_QUEUED_THREAD_TIMER_EVENTS = 65536;
+
+	struct TraceEvent
+	{
+		LLFastTimer::NamedTimer*	mTimer;			// NULL for a frame marker.
+		U32							mThreadIndex;
+		U64							mStartTime;		// In getCPUClockCount32() units, but without wrapping around.
+		U32							mDuration;
+	};
+	std::vector<TraceEvent> sTraceEvents;
+	std::map<U32, std::string> sTraceThreadNames;
+	U64 sTraceStartTime;
+	const size_t MAX_TRACE_EVENTS = 4 * 1024 * 1024;
+}
+
+class LLFastTimer::ThreadTimerData : public LLThreadLocalDataMember
+{
+public:
+	ThreadTimerData(std::string const& name);
+	/*virtual*/ ~ThreadTimerData();
+
+	ThreadTimer*		mCurTimer;
+	std::string			mName;
+	U32					mThreadIndex;
+	AIThreadSafeSimpleDC<thread_timer_event_list_t> mEvents;
+};
+
+typedef std::vector<LLFastTimer::ThreadTimerData*> thread_timer_data_list_t;
+static AIThreadSafeSimpleDC<thread_timer_data_list_t> sThreadTimerDataList;
+static U32 sNextThreadTimerIndex = 1;	// 0 is the main thread. Protected by sThreadTimerDataList.
+
+LLFastTimer::ThreadTimerData::ThreadTimerData(std::string const& name) : mCurTimer(NULL), mName(name)
+{
+	AIAccess<thread_timer_data_list_t> list_w(sThreadTimerDataList);
+	mThreadIndex = sNextThreadTimerIndex++;
+	list_w->push_back(this);
+}
+
+LLFastTimer::ThreadTimerData::~ThreadTimerData()
+{
+	AIAccess<thread_timer_data_list_t> list_w(sThreadTimerDataList);
+	list_w->erase(std::find(list_w->begin(), list_w->end(), this));
+}
+
+LLFastTimer::ThreadTimer::ThreadTimer(DeclareTimer& timer) : mTimer(timer.mTimer), mChildTime(0)
+{
+	LLThreadLocalData& tldata = LLThreadLocalData::tldata();
+	if (!tldata.mFastTimerData)
+	{
+		tldata.mFastTimerData = new ThreadTimerData(tldata.mName);
+	}
+	mData = static_cast<ThreadTimerData*>(tldata.mFastTimerData);
+	mLastTimer = mData->mCurTimer;
+	mData->mCurTimer = this;
+	mStartTime = getCPUClockCount32();
+}
+
+LLFastTimer::ThreadTimer::~ThreadTimer()
+{
+	U32 total_time = getCPUClockCount32() - mStartTime;
+	if (mLastTimer)
+	{
+		mLastTimer->mChildTime += total_time;
+	}
+	mData->mCurTimer = mLastTimer;
+
+	ThreadTimerEvent event = { &mTimer, mLastTimer ? &mLastTimer->mTimer : NULL, mStartTime, total_time, total_time - mChildTime };
+	AIAccess<thread_timer_event_list_t> events_w(mData->mEvents);
+	if (events_w->size() < MAX_QUEUED_THREAD_TIMER_EVENTS)
+	{
+		events_w->push_back(event);
+	}
+}
+
+//static
+void LLFastTimer::collectThreadTimers()
+{
+	NamedTimer* root = NamedTimerFactory::instance().getRootTimer();
+	thread_timer_event_list_t events;
+	AIAccess<thread_timer_data_list_t> list_w(sThreadTimerDataList);
+	for (thread_timer_data_list_t::iterator data = list_w->begin(); data != list_w->end(); ++data)
+	{
+		events.swap(*AIAccess<thread_timer_event_list_t>((*data)->mEvents));
+		if (sTrace && !events.empty())
+		{
+			sTraceThreadNames[(*data)->mThreadIndex] = (*data)->mName;
+		}
+		for (thread_timer_event_list_t::iterator event = events.begin(); event != events.end(); ++event)
+		{
+			NamedTimer* timer = event->mTimer;
+			if (event->mCaller && timer->getParent() == root)
+			{
+				// Don't create a loop when timers call each other both ways.
+				NamedTimer* ancestor = event->mCaller;
+				while (ancestor && ancestor != timer)
+				{
+					ancestor = ancestor->getParent();
+				}
+				if (!ancestor)
+				{
+					timer->setParent(event->mCaller);
+				}
+			}
+			FrameState& state = timer->getFrameState();
+			state.mSelfTimeCounter += event->mSelfTime;
+			state.mCalls++;
+			if (sTrace)
+			{
+				recordTraceEvent(timer, (*data)->mThreadIndex, event->mStartTime, event->mDuration);
+			}
+		}
+		events.clear();
+	}
+}
+
+//static
+void LLFastTimer::recordTraceEvent(NamedTimer* timer, U32 thread_index, U32 start_time, U32 duration)
+{
+	// Main thread timers call this directly; LLFastTimer is not supposed
+	// to be used elsewhere, but don't corrupt the trace if it is.
+	if (!AIThreadID::in_main_thread())
+	{
+		return;
+	}
+	// getCPUClockCount32() wraps around every few minutes. Every call ended no longer than
+	// a frame ago, so extend its start time relative to the current 64-bit clock.
+	U64 const now = getCPUClockCount64() >> 8;
+	U64 const start = now - (U32)((U32)now - start_time);
+	// Skip calls that started before the trace.
+	if (start < sTraceStartTime)
+	{
+		return;
+	}
+	if (sTraceEvents.size() >= MAX_TRACE_EVENTS)
+	{
+		llwarns << "Fast timer trace is full, stopping trace." << llendl;
+		sTrace = false;
+		return;
+	}
+	TraceEvent event = { timer, thread_index, start, duration };
+	sTraceEvents.push_back(event);
+}
+
+//static
+void LLFastTimer::startTrace()
+{
+	sTraceEvents.clear();
+	sTraceThreadNames.clear();
+	sTraceThreadNames[0] = "main thread";
+	sTraceStartTime = getCPUClockCount64() >> 8;
+	sTrace = true;
+}
+
+//static
+void LLFastTimer::stopTrace()
+{
+	sTrace = false;
+}
+
+static void write_json_string(std::ostream& os, std::string const& str)
+{
+	os << '"';
+	for (std::string::const_iterator c = str.begin(); c != str.end(); ++c)
+	{
+		if (*c == '"' || *c == '\\')
+		{
+			os << '\\';
+		}
+		os << *c;
+	}
+	os << '"';
+}
+
+//static
+void LLFastTimer::writeChromeTrace(std::ostream& os)
+{
+	F64 usec_per_count = 1000000.0 / (F64)countsPerSecond();
+	os << "{\"traceEvents\":[";
+	bool first = true;
+	for (std::map<U32, std::string>::iterator iter = sTraceThreadNames.begin(); iter != sTraceThreadNames.end(); ++iter)
+	{
+		os << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << iter->first << ",\"args\":{\"name\":";
+		write_json_string(os, iter->second);
+		os << "}}";
+		first = false;
+	}
+	S32 frame = 0;
+	for (std::vector<TraceEvent>::iterator event = sTraceEvents.begin(); event != sTraceEvents.end(); ++event)
+	{
+		F64 ts = (F64)(event->mStartTime - sTraceStartTime) * usec_per_count;
+		os << (first ? "\n" : ",\n");
+		first = false;
+		if (!event->mTimer)
+		{
+			os << "{\"name\":\"Frame " << frame++ << "\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":" << ts << "}";
+			continue;
+		}
+		os << "{\"name\":";
+		write_json_string(os, event->mTimer->getName());
+		os << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << event->mThreadIndex
+		   << ",\"ts\":" << ts << ",\"dur\":" << (F64)event->mDuration * usec_per_count << "}";
+	}
+	os << "\n]}\n";
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 //static
 void LLFastTimer::nextFrame()
 {
@@ -854,6 +1088,12 @@ void LLFastTimer::nextFrame()
 		llinfos << "Slow frame, fast timers inaccurate" << llendl;
 	}
 
+	collectThreadTimers();
+	if (sTrace)
+	{
+		recordTraceEvent(NULL, 0, getCPUClockCount32(), 0);
+	}
+
 	if (!sPauseHistory)
 	{
 		NamedTimer::processTimes();
@@ -919,6 +1159,36 @@ void LLFastTimer::writeLog(std::ostream& os)
 	}
 }
 
+//static
+void LLFastTimer::writeJSONLog(std::ostream& os)
+{
+	static S32 frame = 0;
+	while (!sLogQueue.empty())
+	{
+		LLSD& sd = sLogQueue.front();
+		os << "{\"frame\":" << frame++ << ",\"timers\":{";
+		bool first = true;
+		for (LLSD::map_const_iterator iter = sd.beginMap(); iter != sd.endMap(); ++iter)
+		{
+			// Leave out the timers that didn't run this frame, to keep the file size sane.
+			if (!iter->second["Calls"].asInteger())
+			{
+				continue;
+			}
+			if (!first)
+			{
+				os << ',';
+			}
+			first = false;
+			write_json_string(os, iter->first);
+			os << ":{\"ms\":" << iter->second["Time"].asReal() << ",\"calls\":" << iter->second["Calls"].asInteger() << '}';
+		}
+		os << "}}\n";
+		LLMutexLock lock(sLogLock);
+		sLogQueue.pop();
+	}
+}
+
 //static
 const LLFastTimer::NamedTimer* LLFastTimer::getTimerByName(const std::string& name)
 {
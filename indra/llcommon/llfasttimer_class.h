@@ -36,6 +36,7 @@
 class LLMutex;
 
 #include <queue>
+#include <iosfwd>
 #include "llsd.h"
 
 LL_COMMON_API void assert_main_thread();
@@ -44,6 +45,7 @@ class LL_COMMON_API LLFastTimer
 {
 public:
 	class NamedTimer;
+	class ThreadTimerData;
 
 	struct LL_COMMON_API FrameState
 	{
@@ -145,10 +147,28 @@ public:
 		DeclareTimer(const std::string& name);
 
 	private:
+		friend class ThreadTimer;
 		NamedTimer&		mTimer;
 		FrameState*		mFrameState;
 	};
 
+	// Scoped timer for threads other than the main thread, which may not use
+	// the (main thread only) LLFastTimer stack. Calls are recorded per thread
+	// and folded into the NamedTimer hierarchy by nextFrame().
+	class LL_COMMON_API ThreadTimer
+	{
+	public:
+		ThreadTimer(DeclareTimer& timer);
+		~ThreadTimer();
+
+	private:
+		NamedTimer&			mTimer;
+		U32					mStartTime;
+		U32					mChildTime;
+		ThreadTimer*		mLastTimer;
+		ThreadTimerData*	mData;
+	};
+
 public:
 	LLFastTimer(LLFastTimer::FrameState* state);
 
@@ -201,6 +221,11 @@ public:
 		// do this in the destructor in case of recursion to get topmost caller
 		frame_state->mLastCaller = mLastTimerData.mNamedTimer;
 
+		if (LL_UNLIKELY(sTrace))
+		{
+			recordTraceEvent(frame_state->mTimer, 0, mStartTime, total_time);
+		}
+
 		// we are only tracking self time, so subtract our total time delta from parents
 		mLastTimerData.mChildTime += total_time;
 
@@ -246,8 +271,17 @@ public:
 	static S32 getCurFrameIndex() { return sCurFrameIndex; }
 
 	static void writeLog(std::ostream& os);
+	// Like writeLog, but one JSON object per frame and line.
+	static void writeJSONLog(std::ostream& os);
 	static const NamedTimer* getTimerByName(const std::string& name);
 
+	// Capture every timer call on every thread, for export in the
+	// Chrome trace event format (load the file in chrome://tracing).
+	static void startTrace();
+	static void stopTrace();
+	static bool isTracing() { return sTrace; }
+	static void writeChromeTrace(std::ostream& os);
+
 	struct CurTimerData
 	{
 		LLFastTimer*	mCurTimer;
@@ -262,6 +296,12 @@ private:
 	static U32 getCPUClockCount32();
 	static U64 getCPUClockCount64();
 
+	// Fold the calls recorded by ThreadTimer objects into the frame states.
+	static void collectThreadTimers();
+	static void recordTraceEvent(NamedTimer* timer, U32 thread_index, U32 start_time, U32 duration);
+
+	static bool				sTrace;
+
 	static S32				sCurFrameIndex;
 	static S32				sLastFrameIndex;
 	static U64				sLastFrameTime;
@@ -54,11 +54,48 @@ int LLMemoryStreamBuf::underflow()
 	//lldebugs << "LLMemoryStreamBuf::underflow()" << llendl;
 	if(gptr() < egptr())
 	{
-		return *gptr();
+		return traits_type::to_int_type(*gptr());
 	}
 	return EOF;
 }
 
+LLMemoryStreamBuf::pos_type LLMemoryStreamBuf::seekoff(off_type off, std::ios_base::seekdir way, std::ios_base::openmode which)
+{
+	// Only the get area exists, so this is all that is needed for tellg()
+	// and seekg() on an LLMemoryStream.
+	if (!(which & std::ios_base::in))
+	{
+		return pos_type(off_type(-1));
+	}
+	off_type base;
+	switch (way)
+	{
+	case std::ios_base::beg:
+		base = 0;
+		break;
+	case std::ios_base::cur:
+		base = gptr() - eback();
+		break;
+	case std::ios_base::end:
+		base = egptr() - eback();
+		break;
+	default:
+		return pos_type(off_type(-1));
+	}
+	off_type pos = base + off;
+	if (pos < 0 || pos > egptr() - eback())
+	{
+		return pos_type(off_type(-1));
+	}
+	setg(eback(), eback() + pos, egptr());
+	return pos_type(pos);
+}
+
+LLMemoryStreamBuf::pos_type LLMemoryStreamBuf::seekpos(pos_type pos, std::ios_base::openmode which)
+{
+	return seekoff(off_type(pos), std::ios_base::beg, which);
+}
+
 /** 
  * @class LLMemoryStreamBuf
  */
@@ -62,6 +62,8 @@ public:
 
 protected:
 	int underflow();
+	pos_type seekoff(off_type off, std::ios_base::seekdir way, std::ios_base::openmode which);
+	pos_type seekpos(pos_type pos, std::ios_base::openmode which);
 	//std::streamsize xsgetn(char* dest, std::streamsize n);
 };
 
@@ -28,6 +28,9 @@
 
 #include "llstl.h"
 #include "lltimer.h"	// ms_sleep()
+#include "llfasttimer.h"
+
+static LLFastTimer::DeclareTimer FTM_QUEUED_THREAD_REQUEST("Queued Thread Request");
 
 //============================================================================
 
@@ -556,7 +559,11 @@ void LLQueuedThread::run()
 
 		threadedUpdate();
 		
-		int res = processNextRequest();
+		int res;
+		{
+			LLFastTimer::ThreadTimer t(FTM_QUEUED_THREAD_REQUEST);
+			res = processNextRequest();
+		}
 		if (res == 0)
 		{
 			mIdleThread = TRUE;
@@ -252,6 +252,8 @@ public:
 		Date	asDate() const;
 		URI		asURI() const;
 		Binary	asBinary() const;
+		// Like asBinary(), without the copy. Valid as long as this LLSD is not changed.
+		const Binary& asBinaryRef() const;
 
 		operator Boolean() const	{ return asBoolean(); }
 		operator Integer() const	{ return asInteger(); }
@@ -30,6 +30,7 @@
 #include "llsdserialize.h"
 #include "llpointer.h"
 #include "llstreamtools.h" // for fullread
+#include "llmemorystream.h"
 
 #include <iostream>
 #include "apr_base64.h"
@@ -2081,92 +2082,98 @@ std::string zip_llsd(LLSD& data)
 }
 
 //decompress a block of LLSD from provided istream
-// not very efficient -- creats a copy of decompressed LLSD block in memory
-// and deserializes from that copy using LLSDSerialize
 bool unzip_llsd(LLSD& data, std::istream& is, S32 size)
 {
-	U8* result = NULL;
-	U32 cur_size = 0;
-	z_stream strm;
-		
-	const U32 CHUNK = 65536;
+	U8* in = new U8[size];
+	is.read((char*) in, size);
 
-	U8 *in = new U8[size];
-	is.read((char*) in, size); 
+	bool result = unzip_llsd(data, in, size);
 
-	U8 out[CHUNK];
-		
+	delete [] in;
+	return result;
+}
+
+//decompress a block of LLSD from memory
+// inflates straight into one growing buffer and parses the LLSD from that
+// buffer in place, without intermediate chunk or string copies
+bool unzip_llsd(LLSD& data, const U8* in, S32 size)
+{
+	if (!in || size <= 0)
+	{
+		return false;
+	}
+
+	z_stream strm;
 	strm.zalloc = Z_NULL;
 	strm.zfree = Z_NULL;
 	strm.opaque = Z_NULL;
 	strm.avail_in = size;
-	strm.next_in = in;
+	strm.next_in = (Bytef*) in;
 
-	S32 ret = inflateInit(&strm);
-	
-	do
+	if (inflateInit(&strm) != Z_OK)
 	{
-		strm.avail_out = CHUNK;
-		strm.next_out = out;
+		return false;
+	}
+
+	// Compressed LLSD (mostly mesh data) typically inflates to a few times its
+	// size; start there and grow geometrically when that is not enough.
+	const U32 MIN_CAPACITY = 65536;
+	U32 capacity = llmax((U32) size * 4, MIN_CAPACITY);
+	U8* result = (U8*) malloc(capacity);
+	U32 cur_size = 0;
+	S32 ret = Z_OK;
+
+	while (result)
+	{
+		strm.avail_out = capacity - cur_size;
+		strm.next_out = result + cur_size;
 		ret = inflate(&strm, Z_NO_FLUSH);
-		if (ret == Z_STREAM_ERROR)
-		{
-			inflateEnd(&strm);
-			free(result);
-			delete [] in;
-			return false;
-		}
-		
-		switch (ret)
+		cur_size = capacity - strm.avail_out;
+
+		if (ret != Z_OK)
 		{
-		case Z_NEED_DICT:
-			ret = Z_DATA_ERROR;
-		case Z_DATA_ERROR:
-		case Z_MEM_ERROR:
-			inflateEnd(&strm);
-			free(result);
-			delete [] in;
-			return false;
 			break;
 		}
 
-		U32 have = CHUNK-strm.avail_out;
-
-		result = (U8*) realloc(result, cur_size + have);
-		memcpy(result+cur_size, out, have);
-		cur_size += have;
-
-	} while (ret == Z_OK);
+		if (strm.avail_out == 0)
+		{
+			capacity *= 2;
+			U8* grown = (U8*) realloc(result, capacity);
+			if (!grown)
+			{
+				free(result);
+				result = NULL;
+			}
+			else
+			{
+				result = grown;
+			}
+		}
+	}
 
 	inflateEnd(&strm);
-	delete [] in;
 
-	if (ret != Z_STREAM_END)
+	if (!result || ret != Z_STREAM_END)
 	{
 		free(result);
 		return false;
 	}
 
 	//result now points to the decompressed LLSD block
+	U32 offset = 0;
+	static const std::string deprecated_header("<? LLSD/Binary ?>");
+	if (cur_size >= deprecated_header.size() &&
+		!memcmp(result, deprecated_header.data(), deprecated_header.size()))
 	{
-		std::string res_str((char*) result, cur_size);
-
-		std::string deprecated_header("<? LLSD/Binary ?>");
-
-		if (res_str.substr(0, deprecated_header.size()) == deprecated_header)
-		{
-			res_str = res_str.substr(deprecated_header.size()+1, cur_size);
-		}
-		cur_size = res_str.size();
+		offset = llmin((U32) deprecated_header.size() + 1, cur_size);
+	}
 
-		std::istringstream istr(res_str);
-		
-		if (!LLSDSerialize::fromBinary(data, istr, cur_size))
-		{
-			llwarns << "Failed to unzip LLSD block" << llendl;
-			free(result);
-			return false;
-		}		
+	LLMemoryStream istr(result + offset, cur_size - offset);
+	if (!LLSDSerialize::fromBinary(data, istr, cur_size - offset))
+	{
+		llwarns << "Failed to unzip LLSD block" << llendl;
+		free(result);
+		return false;
 	}
 
 	free(result);
@@ -36,6 +36,11 @@
 #include <winnls.h> // for WideCharToMultiByte
 #endif
 
+#if (_M_IX86_FP > 1 || defined(_M_X64) || defined(__SSE2__))
+#define LL_STRING_SSE2 1
+#include <emmintrin.h>
+#endif
+
 std::string ll_safe_string(const char* in)
 {
 	if(in) return std::string(in);
@@ -372,9 +377,53 @@ S32 wstring_utf8_length(const LLWString& wstr)
 }
 
 
+// Appends the run of 7-bit characters that starts at in[i] to out, widened
+// to UTF-32. Returns the index of the first byte after the run.
+static S32 append_ascii_run(const U8* in, S32 i, const S32 len, LLWString& out)
+{
+	const S32 start = i;
+#if LL_STRING_SSE2
+	while (i + 16 <= len && !_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(in + i))))
+	{
+		i += 16;
+	}
+#endif
+	while (i < len && in[i] < 0x80)
+	{
+		++i;
+	}
+
+	const size_t old_size = out.size();
+	out.resize(old_size + (i - start));
+	llwchar* dst = &out[old_size];
+	const U8* src = in + start;
+	const U8* const end = in + i;
+#if LL_STRING_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	for (; src + 16 <= end; src += 16, dst += 16)
+	{
+		__m128i bytes = _mm_loadu_si128((const __m128i*)src);
+		__m128i lo = _mm_unpacklo_epi8(bytes, zero);
+		__m128i hi = _mm_unpackhi_epi8(bytes, zero);
+		_mm_storeu_si128((__m128i*)dst, _mm_unpacklo_epi16(lo, zero));
+		_mm_storeu_si128((__m128i*)(dst + 4), _mm_unpackhi_epi16(lo, zero));
+		_mm_storeu_si128((__m128i*)(dst + 8), _mm_unpacklo_epi16(hi, zero));
+		_mm_storeu_si128((__m128i*)(dst + 12), _mm_unpackhi_epi16(hi, zero));
+	}
+#endif
+	while (src < end)
+	{
+		*dst++ = *src++;
+	}
+	return i;
+}
+
 LLWString utf8str_to_wstring(const std::string& utf8str, S32 len)
 {
 	LLWString wout;
+	// Never more characters than bytes.
+	wout.reserve(len);
+	const U8* in = (const U8*)utf8str.data();
 
 	S32 i = 0;
 	while (i < len)
@@ -384,8 +433,9 @@ LLWString utf8str_to_wstring(const std::string& utf8str, S32 len)
 
 		if (cur_char < 0x80)
 		{
-			// Ascii character, just add it
-			unichar = cur_char;
+			// Ascii, copy the whole run at once
+			i = append_ascii_run(in, i, len, wout);
+			continue;
 		}
 		else
 		{
@@ -469,14 +519,49 @@ LLWString utf8str_to_wstring(const std::string& utf8str)
 std::string wstring_to_utf8str(const LLWString& utf32str, S32 len)
 {
 	std::string out;
+	out.reserve(len);
+	const llwchar* in = utf32str.data();
 
 	S32 i = 0;
 	while (i < len)
 	{
+		if (in[i] < 0x80)
+		{
+			// Narrow the whole run of ascii at once. Like wchar_to_utf8chars() followed by
+			// appending the result as a C string did before, U+0000 is dropped.
+#if LL_STRING_SSE2
+			const __m128i high_bits = _mm_set1_epi32(~0x7F);
+			const __m128i zero = _mm_setzero_si128();
+			char narrow[16];
+			while (i + 8 <= len)
+			{
+				__m128i a = _mm_loadu_si128((const __m128i*)(in + i));
+				__m128i b = _mm_loadu_si128((const __m128i*)(in + i + 4));
+				__m128i high = _mm_or_si128(_mm_and_si128(a, high_bits), _mm_and_si128(b, high_bits));
+				__m128i nul = _mm_or_si128(_mm_cmpeq_epi32(a, zero), _mm_cmpeq_epi32(b, zero));
+				if (_mm_movemask_epi8(_mm_cmpeq_epi32(high, zero)) != 0xFFFF || _mm_movemask_epi8(nul))
+				{
+					break;
+				}
+				__m128i packed = _mm_packs_epi32(a, b);
+				_mm_storeu_si128((__m128i*)narrow, _mm_packus_epi16(packed, packed));
+				out.append(narrow, 8);
+				i += 8;
+			}
+#endif
+			while (i < len && in[i] < 0x80)
+			{
+				if (in[i])
+				{
+					out += (char)in[i];
+				}
+				++i;
+			}
+			continue;
+		}
 		char tchars[8];		/* Flawfinder: ignore */
-		S32 n = wchar_to_utf8chars(utf32str[i], tchars);
-		tchars[n] = 0;
-		out += tchars;
+		S32 n = wchar_to_utf8chars(in[i], tchars);
+		out.append(tchars, n);
 		i++;
 	}
 	return out;
@@ -35,28 +35,24 @@
 
 #include "llstringtable.h"
 #include "llstl.h"
+#include "llthread.h"
 
 LLStringTable gStringTable(32768);
 
-LLStringTableEntry::LLStringTableEntry(const char *str)
-: mString(NULL), mCount(1)
-{
-	// Copy string
-	U32 length = (U32)strlen(str) + 1;	 /*Flawfinder: ignore*/
-	length = llmin(length, MAX_STRINGS_LENGTH);
-	mString = new char[length];
-	strncpy(mString, str, length);	 /*Flawfinder: ignore*/
-	mString[length - 1] = 0;
-}
+// Entries and their strings are carved out of chunks of this size.
+static const U32 STRING_TABLE_CHUNK_SIZE = 64 * 1024;
 
-LLStringTableEntry::~LLStringTableEntry()
+LLStringTableEntry::LLStringTableEntry(char* storage, const char* str, U32 length, U32 hash)
+: mString(storage), mCount(1), mHash(hash), mNext(NULL)
 {
-	delete [] mString;
-	mCount = 0;
+	memcpy(mString, str, length);	 /*Flawfinder: ignore*/
+	mString[length] = 0;
 }
 
 LLStringTable::LLStringTable(int tablesize)
-: mUniqueEntries(0)
+: mUniqueEntries(0),
+  mWriteMutex(new LLGlobalMutex),
+  mChunkUsed(STRING_TABLE_CHUNK_SIZE)
 {
 	S32 i;
 	if (!tablesize)
@@ -74,64 +70,63 @@ LLStringTable::LLStringTable(int tablesize)
 		}
 	}
 	mMaxEntries = tablesize;
+	mBuckets = new bucket_t[mMaxEntries];
+}
 
-#if !STRING_TABLE_HASH_MAP
-	// ALlocate strings
-	mStringList = new string_list_ptr_t[mMaxEntries];
-	// Clear strings
-	for (i = 0; i < mMaxEntries; i++)
+LLStringTable::~LLStringTable()
+{
+	delete [] mBuckets;
+	mBuckets = NULL;
+	// Entries are trivially destructible; just release the arena.
+	for_each(mChunks.begin(), mChunks.end(), DeletePointerArray());
+	mChunks.clear();
+	delete mWriteMutex;
+}
+
+// Returns the full hash; the bucket is the low bits of it. Only the part
+// of the string that is actually stored is hashed, and 'length' is set to
+// the length of that part.
+static U32 hash_my_string(const char *str, U32& length)
+{
+	U32 retval = 0;
+	const char* p = str;
+	const char* end = str + MAX_STRINGS_LENGTH - 1;
+	while (*p && p < end)
 	{
-		mStringList[i] = NULL;
+		retval = (retval<<4) + *p;
+		U32 x = (retval & 0xf0000000);
+		if (x) retval = retval ^ (x>>24);
+		retval = retval & (~x);
+		p++;
 	}
-#endif
+	length = (U32)(p - str);
+	return retval;
 }
 
-LLStringTable::~LLStringTable()
+LLStringTableEntry* LLStringTable::findEntry(const char* str, U32 hash) const
 {
-#if !STRING_TABLE_HASH_MAP
-	if (mStringList)
+	for (LLStringTableEntry* entry = mBuckets[hash & (mMaxEntries - 1)]; entry; entry = entry->mNext)
 	{
-		for (S32 i = 0; i < mMaxEntries; i++)
+		if (entry->mHash == hash && !strncmp(entry->mString, str, MAX_STRINGS_LENGTH - 1))
 		{
-			if (mStringList[i])
-			{
-				string_list_t::iterator iter;
-				for (iter = mStringList[i]->begin(); iter != mStringList[i]->end(); iter++)
-					delete *iter; // *iter = (LLStringTableEntry*)
-			}
-			delete mStringList[i];
+			return entry;
 		}
-		delete [] mStringList;
-		mStringList = NULL;
 	}
-#else
-	// Need to clean up the string hash
-	for_each(mStringHash.begin(), mStringHash.end(), DeletePairedPointer());
-	mStringHash.clear();
-#endif
+	return NULL;
 }
 
-
-static U32 hash_my_string(const char *str, int max_entries)
+char* LLStringTable::allocate(U32 size)
 {
-	U32 retval = 0;
-#if 0
-	while (*str)
-	{
-		retval <<= 1;
-		retval += *str++;
-	}
-#else
-	while (*str)
+	// Keep entries pointer aligned.
+	size = (size + sizeof(void*) - 1) & ~(U32)(sizeof(void*) - 1);
+	if (mChunkUsed + size > STRING_TABLE_CHUNK_SIZE)
 	{
-		retval = (retval<<4) + *str;
-		U32 x = (retval & 0xf0000000);
-		if (x) retval = retval ^ (x>>24);
-		retval = retval & (~x);
-		str++;
+		mChunks.push_back(new char[STRING_TABLE_CHUNK_SIZE]);
+		mChunkUsed = 0;
 	}
-#endif
-	return (retval & (max_entries-1)); // max_entries is gauranteed to be power of 2
+	char* result = mChunks.back() + mChunkUsed;
+	mChunkUsed += size;
+	return result;
 }
 
 char* LLStringTable::checkString(const std::string& str)
@@ -161,43 +156,9 @@ LLStringTableEntry* LLStringTable::checkStringEntry(const char *str)
 {
 	if (str)
 	{
-		char *ret_val;
-		LLStringTableEntry	*entry;
-		U32					hash_value = hash_my_string(str, mMaxEntries);
-#if STRING_TABLE_HASH_MAP
-#if 1 // Microsoft
-		string_hash_t::iterator lower = mStringHash.lower_bound(hash_value);
-		string_hash_t::iterator upper = mStringHash.upper_bound(hash_value);
-#else // stlport
-		std::pair<string_hash_t::iterator, string_hash_t::iterator> P = mStringHash.equal_range(hash_value);
-		string_hash_t::iterator lower = P.first;
-		string_hash_t::iterator upper = P.second;
-#endif
-		for (string_hash_t::iterator iter = lower; iter != upper; iter++)
-		{
-			entry = iter->second;
-			ret_val = entry->mString;
-			if (!strncmp(ret_val, str, MAX_STRINGS_LENGTH))
-			{
-				return entry;
-			}
-		}
-#else
-		string_list_t		*strlist = mStringList[hash_value];
-		if (strlist)
-		{
-			string_list_t::iterator iter;
-			for (iter = strlist->begin(); iter != strlist->end(); iter++)
-			{
-				entry = *iter;
-				ret_val = entry->mString;
-				if (!strncmp(ret_val, str, MAX_STRINGS_LENGTH))
-				{
-					return entry;
-				}
-			}
-		}
-#endif
+		U32 length;
+		U32 hash_value = hash_my_string(str, length);
+		return findEntry(str, hash_value);
 	}
 	return NULL;
 }
@@ -229,136 +190,73 @@ LLStringTableEntry* LLStringTable::addStringEntry(const std::string& str)
 
 LLStringTableEntry* LLStringTable::addStringEntry(const char *str)
 {
-	if (str)
+	if (!str)
 	{
-		char *ret_val = NULL;
-		LLStringTableEntry	*entry;
-		U32					hash_value = hash_my_string(str, mMaxEntries);
-#if STRING_TABLE_HASH_MAP
-#if 1 // Microsoft
-		string_hash_t::iterator lower = mStringHash.lower_bound(hash_value);
-		string_hash_t::iterator upper = mStringHash.upper_bound(hash_value);
-#else // stlport
-		std::pair<string_hash_t::iterator, string_hash_t::iterator> P = mStringHash.equal_range(hash_value);
-		string_hash_t::iterator lower = P.first;
-		string_hash_t::iterator upper = P.second;
-#endif
-		for (string_hash_t::iterator iter = lower; iter != upper; iter++)
-		{
-			entry = iter->second;
-			ret_val = entry->mString;
-			if (!strncmp(ret_val, str, MAX_STRINGS_LENGTH))
-			{
-				entry->incCount();
-				return entry;
-			}
-		}
-
-		// not found, so add!
-		LLStringTableEntry* newentry = new LLStringTableEntry(str);
-		ret_val = newentry->mString;
-		mStringHash.insert(string_hash_t::value_type(hash_value, newentry));
-#else
-		string_list_t		*strlist = mStringList[hash_value];
+		return NULL;
+	}
 
-		if (strlist)
-		{
-			string_list_t::iterator iter;
-			for (iter = strlist->begin(); iter != strlist->end(); iter++)
-			{
-				entry = *iter;
-				ret_val = entry->mString;
-				if (!strncmp(ret_val, str, MAX_STRINGS_LENGTH))
-				{
-					entry->incCount();
-					return entry;
-				}
-			}
-		}
-		else
-		{
-			mStringList[hash_value] = new string_list_t;
-			strlist = mStringList[hash_value];
-		}
+	U32 length;
+	U32 hash_value = hash_my_string(str, length);
 
-		// not found, so add!
-		LLStringTableEntry *newentry = new LLStringTableEntry(str);
-		//ret_val = newentry->mString;
-		strlist->push_front(newentry);
-#endif
-		mUniqueEntries++;
-		return newentry;
+	// Common case: the string is already there and no lock is needed.
+	LLStringTableEntry* entry = findEntry(str, hash_value);
+	if (entry)
+	{
+		entry->incCount();
+		return entry;
 	}
-	else
+
+	LLMutexLock lock(mWriteMutex);
+
+	// Somebody else might have added it in the meantime.
+	entry = findEntry(str, hash_value);
+	if (entry)
 	{
-		return NULL;
+		entry->incCount();
+		return entry;
 	}
+
+	// not found, so add!
+	char* storage = allocate(sizeof(LLStringTableEntry) + length + 1);
+	entry = new (storage) LLStringTableEntry(storage + sizeof(LLStringTableEntry), str, length, hash_value);
+	bucket_t& bucket = mBuckets[hash_value & (mMaxEntries - 1)];
+	entry->mNext = (LLStringTableEntry*)bucket;
+	// Publish the fully constructed entry.
+	bucket = entry;
+	mUniqueEntries++;
+	return entry;
 }
 
 void LLStringTable::removeString(const char *str)
 {
-	if (str)
+	if (!str)
 	{
-		char *ret_val;
-		LLStringTableEntry	*entry;
-		U32					hash_value = hash_my_string(str, mMaxEntries);
-#if STRING_TABLE_HASH_MAP
-		{
-#if 1 // Microsoft
-			string_hash_t::iterator lower = mStringHash.lower_bound(hash_value);
-			string_hash_t::iterator upper = mStringHash.upper_bound(hash_value);
-#else // stlport
-			std::pair<string_hash_t::iterator, string_hash_t::iterator> P = mStringHash.equal_range(hash_value);
-			string_hash_t::iterator lower = P.first;
-			string_hash_t::iterator upper = P.second;
-#endif
-			for (string_hash_t::iterator iter = lower; iter != upper; iter++)
-			{
-				entry = iter->second;
-				ret_val = entry->mString;
-				if (!strncmp(ret_val, str, MAX_STRINGS_LENGTH))
-				{
-					if (!entry->decCount())
-					{
-						mUniqueEntries--;
-						if (mUniqueEntries < 0)
-						{
-							llerror("LLStringTable:removeString trying to remove too many strings!", 0);
-						}
-						delete iter->second;
-						mStringHash.erase(iter);
-					}
-					return;
-				}
-			}
-		}
-#else
-		string_list_t		*strlist = mStringList[hash_value];
+		return;
+	}
+
+	U32 length;
+	U32 hash_value = hash_my_string(str, length);
 
-		if (strlist)
+	LLMutexLock lock(mWriteMutex);
+
+	bucket_t* link = &mBuckets[hash_value & (mMaxEntries - 1)];
+	for (LLStringTableEntry* entry = *link; entry; link = &entry->mNext, entry = *link)
+	{
+		if (entry->mHash == hash_value && !strncmp(entry->mString, str, MAX_STRINGS_LENGTH - 1))
 		{
-			string_list_t::iterator iter;
-			for (iter = strlist->begin(); iter != strlist->end(); iter++)
+			if (!entry->decCount())
 			{
-				entry = *iter;
-				ret_val = entry->mString;
-				if (!strncmp(ret_val, str, MAX_STRINGS_LENGTH))
+				mUniqueEntries--;
+				if (mUniqueEntries < 0)
 				{
-					if (!entry->decCount())
-					{
-						mUniqueEntries--;
-						if (mUniqueEntries < 0)
-						{
-							llerror("LLStringTable:removeString trying to remove too many strings!", 0);
-						}
-						strlist->remove(entry);
-						delete entry;
-					}
-					return;
+					llerror("LLStringTable:removeString trying to remove too many strings!", 0);
 				}
+				// Unlink, but leave entry->mNext intact for any reader that is
+				// still walking this chain. The memory is reclaimed with the arena.
+				*link = (LLStringTableEntry*)entry->mNext;
 			}
+			return;
 		}
-#endif
 	}
 }
 
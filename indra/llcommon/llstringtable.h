@@ -35,42 +35,38 @@
 #define LL_STRING_TABLE_H
 
 #include "lldefs.h"
+#include "llatomic.h"
 #include "llformat.h"
 #include "llstl.h"
 #include <list>
 #include <set>
+#include <vector>
 
-#if LL_WINDOWS
-# if (_MSC_VER >= 1300 && _MSC_VER < 1400)
-#  define STRING_TABLE_HASH_MAP 1
-# endif
-#else
-//# define STRING_TABLE_HASH_MAP 1
-#endif
-
-#if STRING_TABLE_HASH_MAP
-# if LL_WINDOWS
-#  include <hash_map>
-# else
-#  include <ext/hash_map>
-# endif
-#endif
+class LLMutex;
 
 const U32 MAX_STRINGS_LENGTH = 256;
 
 class LL_COMMON_API LLStringTableEntry
 {
 public:
-	LLStringTableEntry(const char *str);
-	~LLStringTableEntry();
+	// Entries (and their string) live in the arena of the table that owns them.
+	LLStringTableEntry(char* storage, const char* str, U32 length, U32 hash);
 
 	void incCount()		{ mCount++; }
 	BOOL decCount()		{ return --mCount; }
 
 	char *mString;
-	S32  mCount;
+	LLAtomicS32 mCount;
+	U32 mHash;
+	LLAtomicPtr<LLStringTableEntry> mNext;
 };
 
+// Lookups (checkString*, and addString* of a string that is already in the
+// table) don't take any lock and may run concurrently from any thread.
+// Inserting and removing serialize on a mutex. Entries are never freed
+// before the table itself is destroyed, so a returned pointer stays valid
+// even after the string has been removed. Removing a string must not race
+// with adding that same string.
 class LL_COMMON_API LLStringTable
 {
 public:
@@ -90,19 +86,18 @@ public:
 
 	S32 mMaxEntries;
 	S32 mUniqueEntries;
-	
-#if STRING_TABLE_HASH_MAP
-#if LL_WINDOWS
-	typedef std::hash_multimap<U32, LLStringTableEntry *> string_hash_t;
-#else
-	typedef __gnu_cxx::hash_multimap<U32, LLStringTableEntry *> string_hash_t;
-#endif
-	string_hash_t mStringHash;
-#else
-	typedef std::list<LLStringTableEntry *> string_list_t;
-	typedef string_list_t * string_list_ptr_t;
-	string_list_ptr_t	*mStringList;
-#endif	
+
+private:
+	LLStringTableEntry* findEntry(const char* str, U32 hash) const;
+	// Called with mWriteMutex locked.
+	char* allocate(U32 size);
+
+	typedef LLAtomicPtr<LLStringTableEntry> bucket_t;
+	bucket_t* mBuckets;
+
+	LLMutex* mWriteMutex;
+	std::vector<char*> mChunks;
+	U32 mChunkUsed;
 };
 
 extern LL_COMMON_API LLStringTable gStringTable;
@@ -297,7 +297,7 @@ void LLThread::wakeLocked()
 // The thread private handle to access the LLThreadLocalData instance.
 apr_threadkey_t* LLThreadLocalData::sThreadLocalDataKey;
 
-LLThreadLocalData::LLThreadLocalData(char const* name) : mCurlMultiHandle(NULL), mCurlErrorBuffer(NULL), mName(name)
+LLThreadLocalData::LLThreadLocalData(char const* name) : mCurlMultiHandle(NULL), mCurlErrorBuffer(NULL), mFastTimerData(NULL), mName(name)
 {
 }
 
@@ -305,6 +305,7 @@ LLThreadLocalData::~LLThreadLocalData()
 {
   delete mCurlMultiHandle;
   delete [] mCurlErrorBuffer;
+  delete mFastTimerData;
 }
 
 //static
@@ -67,6 +67,7 @@ public:
 	LLVolatileAPRPool mVolatileAPRPool;
 	LLThreadLocalDataMember* mCurlMultiHandle;	// Initialized by AICurlMultiHandle::getInstance
 	char* mCurlErrorBuffer;						// NULL, or pointing to a buffer used by libcurl.
+	LLThreadLocalDataMember* mFastTimerData;	// Initialized by the first LLFastTimer::ThreadTimer in this thread.
 	std::string mName;							// "main thread", or a copy of LLThread::mName.
 
 	static void init(void);
@@ -0,0 +1,322 @@
+/**
+ * @file lluuidhashmap.h
+ * @brief Open-addressed hash map and set keyed on LLUUID.
+ *
+ * $LicenseInfo:firstyear=2013&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLUUIDHASHMAP_H
+#define LL_LLUUIDHASHMAP_H
+
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "lluuid.h"
+
+// UUIDs are (for all practical purposes) random, so the bits themselves make
+// a perfectly good hash; fold both halves together in case one of them is
+// constant, as it is for some well known ids.
+inline size_t ll_uuid_hash(const LLUUID& id)
+{
+	U64 lo, hi;
+	memcpy(&lo, id.mData, sizeof(U64));
+	memcpy(&hi, id.mData + sizeof(U64), sizeof(U64));
+	return (size_t)(lo ^ hi);
+}
+
+// Linear probing table with backward shift deletion (no tombstones).
+// Slots are stored contiguously, so a lookup usually touches a single cache
+// line instead of chasing bucket nodes like std::map or boost::unordered_map.
+//
+// Note: erase() may move an element into an earlier slot, so don't erase
+// while iterating; collect the keys first.
+template <class VALUE, class KEY_OF>
+class LLUUIDHashTable
+{
+public:
+	typedef VALUE value_type;
+	typedef size_t size_type;
+
+	template <class TABLE, class V>
+	class iterator_base
+	{
+	public:
+		iterator_base() : mTable(NULL), mIndex(0) { }
+		iterator_base(TABLE* table, size_t index) : mTable(table), mIndex(index) { skipEmpty(); }
+		// Allow conversion from iterator to const_iterator.
+		template <class T2, class V2>
+		iterator_base(const iterator_base<T2, V2>& rhs) : mTable(rhs.mTable), mIndex(rhs.mIndex) { }
+
+		V& operator*() const { return mTable->mSlots[mIndex]; }
+		V* operator->() const { return &mTable->mSlots[mIndex]; }
+		iterator_base& operator++() { ++mIndex; skipEmpty(); return *this; }
+		iterator_base operator++(int) { iterator_base tmp(*this); ++*this; return tmp; }
+
+		template <class T2, class V2>
+		bool operator==(const iterator_base<T2, V2>& rhs) const { return mIndex == rhs.mIndex; }
+		template <class T2, class V2>
+		bool operator!=(const iterator_base<T2, V2>& rhs) const { return mIndex != rhs.mIndex; }
+
+	private:
+		void skipEmpty()
+		{
+			size_t capacity = mTable->mUsed.size();
+			while (mIndex < capacity && !mTable->mUsed[mIndex])
+			{
+				++mIndex;
+			}
+		}
+
+		template <class T2, class V2> friend class iterator_base;
+		friend class LLUUIDHashTable;
+		TABLE* mTable;
+		size_t mIndex;
+	};
+
+	typedef iterator_base<LLUUIDHashTable, value_type> iterator;
+	typedef iterator_base<const LLUUIDHashTable, const value_type> const_iterator;
+
+	LLUUIDHashTable() : mSize(0) { }
+
+	size_type size() const { return mSize; }
+	bool empty() const { return mSize == 0; }
+
+	iterator begin() { return iterator(this, 0); }
+	iterator end() { return iterator(this, mUsed.size()); }
+	const_iterator begin() const { return const_iterator(this, 0); }
+	const_iterator end() const { return const_iterator(this, mUsed.size()); }
+
+	void clear()
+	{
+		mSlots.clear();
+		mUsed.clear();
+		mSize = 0;
+	}
+
+	void swap(LLUUIDHashTable& rhs)
+	{
+		mSlots.swap(rhs.mSlots);
+		mUsed.swap(rhs.mUsed);
+		std::swap(mSize, rhs.mSize);
+	}
+
+	// Make room for at least 'count' elements without rehashing.
+	void reserve(size_type count)
+	{
+		size_t capacity = 16;
+		while (capacity * 3 < count * 4)
+		{
+			capacity <<= 1;
+		}
+		if (capacity > mUsed.size())
+		{
+			rehash(capacity);
+		}
+	}
+
+	iterator find(const LLUUID& key)
+	{
+		return iterator(this, findIndex(key));
+	}
+
+	const_iterator find(const LLUUID& key) const
+	{
+		return const_iterator(this, findIndex(key));
+	}
+
+	size_type count(const LLUUID& key) const
+	{
+		return findIndex(key) != mUsed.size() ? 1 : 0;
+	}
+
+	size_type erase(const LLUUID& key)
+	{
+		size_t index = findIndex(key);
+		if (index == mUsed.size())
+		{
+			return 0;
+		}
+		eraseIndex(index);
+		return 1;
+	}
+
+protected:
+	// Returns the slot holding 'key', claiming an empty one if needed.
+	// The bool is true when the slot was newly claimed.
+	std::pair<size_t, bool> insertKey(const LLUUID& key)
+	{
+		if ((mSize + 1) * 4 > mUsed.size() * 3)
+		{
+			rehash(mUsed.empty() ? 16 : mUsed.size() * 2);
+		}
+		size_t mask = mUsed.size() - 1;
+		size_t index = ll_uuid_hash(key) & mask;
+		while (mUsed[index])
+		{
+			if (KEY_OF::get(mSlots[index]) == key)
+			{
+				return std::make_pair(index, false);
+			}
+			index = (index + 1) & mask;
+		}
+		mUsed[index] = 1;
+		++mSize;
+		return std::make_pair(index, true);
+	}
+
+	size_t findIndex(const LLUUID& key) const
+	{
+		size_t capacity = mUsed.size();
+		if (!mSize)
+		{
+			return capacity;
+		}
+		size_t mask = capacity - 1;
+		size_t index = ll_uuid_hash(key) & mask;
+		while (mUsed[index])
+		{
+			if (KEY_OF::get(mSlots[index]) == key)
+			{
+				return index;
+			}
+			index = (index + 1) & mask;
+		}
+		return capacity;
+	}
+
+	void eraseIndex(size_t hole)
+	{
+		size_t mask = mUsed.size() - 1;
+		size_t next = hole;
+		while (true)
+		{
+			next = (next + 1) & mask;
+			if (!mUsed[next])
+			{
+				break;
+			}
+			// An element may only be moved back into the hole if its home
+			// slot does not lie cyclically in (hole, next].
+			size_t home = ll_uuid_hash(KEY_OF::get(mSlots[next])) & mask;
+			bool stays = hole <= next ? (hole < home && home <= next)
+									  : (hole < home || home <= next);
+			if (!stays)
+			{
+				mSlots[hole] = mSlots[next];
+				hole = next;
+			}
+		}
+		mUsed[hole] = 0;
+		mSlots[hole] = value_type();	// Release whatever the slot held.
+		--mSize;
+	}
+
+	void rehash(size_t capacity)
+	{
+		std::vector<value_type> old_slots(capacity);
+		std::vector<U8> old_used(capacity, 0);
+		old_slots.swap(mSlots);
+		old_used.swap(mUsed);
+		size_t mask = capacity - 1;
+		for (size_t i = 0; i < old_used.size(); ++i)
+		{
+			if (old_used[i])
+			{
+				size_t index = ll_uuid_hash(KEY_OF::get(old_slots[i])) & mask;
+				while (mUsed[index])
+				{
+					index = (index + 1) & mask;
+				}
+				mSlots[index] = old_slots[i];
+				mUsed[index] = 1;
+			}
+		}
+	}
+
+	std::vector<value_type> mSlots;
+	std::vector<U8> mUsed;
+	size_t mSize;
+};
+
+struct LLUUIDHashSetKey
+{
+	static const LLUUID& get(const LLUUID& value) { return value; }
+};
+
+template <class T>
+struct LLUUIDHashMapKey
+{
+	static const LLUUID& get(const std::pair<LLUUID, T>& value) { return value.first; }
+};
+
+// Drop-in for std::set<LLUUID> / boost::unordered_set<LLUUID> where ordering
+// does not matter.
+class LLUUIDHashSet : public LLUUIDHashTable<LLUUID, LLUUIDHashSetKey>
+{
+public:
+	std::pair<iterator, bool> insert(const LLUUID& key)
+	{
+		std::pair<size_t, bool> result = insertKey(key);
+		if (result.second)
+		{
+			mSlots[result.first] = key;
+		}
+		return std::make_pair(iterator(this, result.first), result.second);
+	}
+};
+
+// Drop-in for std::map<LLUUID, T> / boost::unordered_map<LLUUID, T> where
+// ordering does not matter. The key of an element must not be modified
+// through an iterator.
+template <class T>
+class LLUUIDHashMap : public LLUUIDHashTable<std::pair<LLUUID, T>, LLUUIDHashMapKey<T> >
+{
+	typedef LLUUIDHashTable<std::pair<LLUUID, T>, LLUUIDHashMapKey<T> > table_t;
+
+public:
+	typedef LLUUID key_type;
+	typedef T mapped_type;
+	typedef typename table_t::value_type value_type;
+	typedef typename table_t::iterator iterator;
+	typedef typename table_t::const_iterator const_iterator;
+
+	T& operator[](const LLUUID& key)
+	{
+		std::pair<size_t, bool> result = this->insertKey(key);
+		value_type& slot = this->mSlots[result.first];
+		if (result.second)
+		{
+			slot.first = key;
+		}
+		return slot.second;
+	}
+
+	std::pair<iterator, bool> insert(const value_type& value)
+	{
+		std::pair<size_t, bool> result = this->insertKey(value.first);
+		if (result.second)
+		{
+			this->mSlots[result.first] = value;
+		}
+		return std::make_pair(iterator(this, result.first), result.second);
+	}
+};
+
+#endif // LL_LLUUIDHASHMAP_H
@@ -0,0 +1,266 @@
+/**
+ * @file llahocorasick_test.cpp
+ * @brief Checks LLAhoCorasick against a naive scan over the patterns.
+ *
+ * $LicenseInfo:firstyear=2013&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * $/LicenseInfo$
+ */
+
+#include "../linden_common.h"
+#include <map>
+// Class to test
+#include "../llahocorasick.h"
+#include "../llstring.h"
+// Tut header
+#include "../test/lltut.h"
+
+namespace tut
+{
+	struct ahocorasick_test
+	{
+		// Every pattern with its value. Adding a pattern again replaces its value, as in LLAhoCorasick.
+		template <class STRING>
+		struct Naive
+		{
+			typedef std::map<STRING, S32> patterns_t;
+			patterns_t mPatterns;
+
+			// Highest value among the patterns the text starts with.
+			S32 matchPrefix(const STRING& text, size_t start) const
+			{
+				S32 best = -1;
+				for (typename patterns_t::const_iterator it = mPatterns.begin(); it != mPatterns.end(); ++it)
+				{
+					if (text.compare(start, it->first.size(), it->first) == 0 && start + it->first.size() <= text.size())
+					{
+						best = llmax(best, it->second);
+					}
+				}
+				return best;
+			}
+
+			// Of the patterns ending first, the value of the longest one.
+			S32 find(const STRING& text, size_t start, size_t* match_end) const
+			{
+				for (size_t end = start; end <= text.size(); ++end)
+				{
+					const STRING* longest = NULL;
+					S32 value = -1;
+					for (typename patterns_t::const_iterator it = mPatterns.begin(); it != mPatterns.end(); ++it)
+					{
+						size_t length = it->first.size();
+						if (length <= end - start && text.compare(end - length, length, it->first) == 0 &&
+							(!longest || length > longest->size()))
+						{
+							longest = &it->first;
+							value = it->second;
+						}
+					}
+					if (longest)
+					{
+						*match_end = end;
+						return value;
+					}
+				}
+				return -1;
+			}
+		};
+
+		template <class CHAR>
+		void add(LLAhoCorasick<CHAR>& trie, Naive<std::basic_string<CHAR> >& naive, const std::basic_string<CHAR>& pattern, S32 value)
+		{
+			trie.add(pattern, value);
+			naive.mPatterns[pattern] = value;
+		}
+
+		template <class CHAR>
+		void compare(const LLAhoCorasick<CHAR>& trie, const Naive<std::basic_string<CHAR> >& naive, const std::basic_string<CHAR>& text)
+		{
+			const CHAR* base = text.data();
+			for (size_t start = 0; start <= text.size(); ++start)
+			{
+				ensure_equals("matchPrefix", trie.matchPrefix(base + start, base + text.size()), naive.matchPrefix(text, start));
+				const CHAR* match_end = NULL;
+				size_t expected_end = 0;
+				S32 expected = naive.find(text, start, &expected_end);
+				ensure_equals("find", trie.find(base + start, base + text.size(), &match_end), expected);
+				if (expected >= 0)
+				{
+					ensure_equals("find match end", (size_t)(match_end - base), expected_end);
+				}
+			}
+		}
+
+		// Random patterns and texts over a small alphabet, so that they overlap a lot.
+		template <class CHAR>
+		void compareRandom(const CHAR* alphabet, size_t alphabet_size, U32 seed)
+		{
+			for (S32 round = 0; round < 50; ++round)
+			{
+				LLAhoCorasick<CHAR> trie;
+				Naive<std::basic_string<CHAR> > naive;
+				S32 count = 1 + round % 12;
+				for (S32 i = 0; i < count; ++i)
+				{
+					seed = seed * 1103515245 + 12345;
+					std::basic_string<CHAR> pattern;
+					size_t length = 1 + (seed >> 16) % 5;
+					for (size_t j = 0; j < length; ++j)
+					{
+						seed = seed * 1103515245 + 12345;
+						pattern += alphabet[(seed >> 16) % alphabet_size];
+					}
+					add(trie, naive, pattern, i);
+				}
+				trie.compile();
+				for (S32 t = 0; t < 10; ++t)
+				{
+					std::basic_string<CHAR> text;
+					seed = seed * 1103515245 + 12345;
+					size_t length = (seed >> 16) % 40;
+					for (size_t j = 0; j < length; ++j)
+					{
+						seed = seed * 1103515245 + 12345;
+						text += alphabet[(seed >> 16) % alphabet_size];
+					}
+					compare(trie, naive, text);
+				}
+			}
+		}
+	};
+	typedef test_group<ahocorasick_test> ahocorasick_t;
+	typedef ahocorasick_t::object ahocorasick_object_t;
+	tut::ahocorasick_t tut_ahocorasick("LLAhoCorasick");
+
+	// Overlapping patterns, and patterns that are a suffix of another.
+	template<> template<>
+	void ahocorasick_object_t::test<1>()
+	{
+		LLAhoCorasick<char> trie;
+		Naive<std::string> naive;
+		add(trie, naive, std::string("he"), 0);
+		add(trie, naive, std::string("she"), 1);
+		add(trie, naive, std::string("his"), 2);
+		add(trie, naive, std::string("hers"), 3);
+		trie.compile();
+
+		std::string text("ushers");
+		const char* match_end = NULL;
+		ensure_equals("longest of the patterns ending first", trie.find(text.data(), text.data() + text.size(), &match_end), 1);
+		ensure_equals("match end", match_end - text.data(), 4);
+		ensure_equals("suffix found through the failure link", trie.find(text.data() + 2, text.data() + text.size(), &match_end), 0);
+		ensure_equals("suffix match end", match_end - text.data(), 4);
+		ensure_equals("across a failed partial match", trie.find(text.data() + 3, text.data() + text.size()), -1);
+		std::string hishe("hishe");
+		ensure_equals("overlapping matches", trie.find(hishe.data(), hishe.data() + hishe.size(), &match_end), 2);
+		ensure_equals("overlapping match end", match_end - hishe.data(), 3);
+
+		ensure_equals("matchPrefix", trie.matchPrefix(text.data() + 2, text.data() + text.size()), 3);
+		ensure_equals("matchPrefix no match", trie.matchPrefix(text.data(), text.data() + text.size()), -1);
+
+		LLAhoCorasick<char>::node_t node = trie.child(LLAhoCorasick<char>::ROOT, 's');
+		node = trie.child(node, 'h');
+		ensure_equals("inner node has no value", trie.value(node), -1);
+		node = trie.child(node, 'e');
+		ensure_equals("child and value", trie.value(node), 1);
+		ensure("no child", trie.child(node, 'x') == LLAhoCorasick<char>::NO_NODE);
+
+		compare(trie, naive, std::string("ahishershe"));
+		compare(trie, naive, std::string("hhhhehehersherss"));
+
+		// "er" ends inside "hers", at a node that is not a pattern itself.
+		LLAhoCorasick<char> suffix;
+		suffix.add(std::string("hers"), 0);
+		suffix.add(std::string("ers"), 1);
+		suffix.add(std::string("er"), 2);
+		suffix.compile();
+		std::string hers("hers");
+		ensure_equals("suffix of a partial match", suffix.find(hers.data(), hers.data() + hers.size(), &match_end), 2);
+		ensure_equals("suffix of a partial match end", match_end - hers.data(), 3);
+		std::string xhers("xhers");
+		suffix.clear();
+		suffix.add(std::string("hers"), 0);
+		suffix.add(std::string("ers"), 1);
+		suffix.compile();
+		ensure_equals("longest of equal ends", suffix.find(xhers.data(), xhers.data() + xhers.size(), &match_end), 0);
+		ensure_equals("longest of equal ends match end", match_end - xhers.data(), 5);
+		std::string xherx("xherx");
+		ensure_equals("no match after a partial match", suffix.find(xherx.data(), xherx.data() + xherx.size()), -1);
+	}
+
+	// The later token wins: the highest value among equal prefix matches, and adding a pattern again.
+	template<> template<>
+	void ahocorasick_object_t::test<2>()
+	{
+		LLAhoCorasick<llwchar> trie;
+		Naive<LLWString> naive;
+		add(trie, naive, utf8str_to_wstring("//"), 0);
+		add(trie, naive, utf8str_to_wstring("/"), 1);
+		add(trie, naive, utf8str_to_wstring("/*"), 2);
+		LLWString text = utf8str_to_wstring("// comment");
+		ensure_equals("shorter token added later wins", trie.matchPrefix(text.data(), text.data() + text.size()), 1);
+
+		add(trie, naive, utf8str_to_wstring("//"), 3);
+		ensure_equals("same token added again wins", trie.matchPrefix(text.data(), text.data() + text.size()), 3);
+		trie.compile();
+		const llwchar* match_end = NULL;
+		ensure_equals("find ends at the first character", trie.find(text.data(), text.data() + text.size(), &match_end), 1);
+		ensure("find match end", match_end == text.data() + 1);
+		compare(trie, naive, utf8str_to_wstring("a // b /* c */ /"));
+	}
+
+	// Empty automaton and empty patterns.
+	template<> template<>
+	void ahocorasick_object_t::test<3>()
+	{
+		LLAhoCorasick<char> trie;
+		std::string text("text");
+		ensure("new trie is empty", trie.empty());
+		ensure_equals("matchPrefix on empty trie", trie.matchPrefix(text.data(), text.data() + text.size()), -1);
+		ensure_equals("find on empty trie", trie.find(text.data(), text.data() + text.size()), -1);
+
+		// An empty pattern matches at the start of any text, including an empty one.
+		Naive<std::string> naive;
+		add(trie, naive, std::string(), 5);
+		add(trie, naive, std::string("ex"), 4);
+		trie.compile();
+		ensure("not empty", !trie.empty());
+		const char* match_end = NULL;
+		ensure_equals("find empty pattern", trie.find(text.data(), text.data() + text.size(), &match_end), 5);
+		ensure("empty pattern ends where it starts", match_end == text.data());
+		ensure_equals("find in empty text", trie.find(text.data(), text.data()), 5);
+		ensure_equals("matchPrefix takes the highest value", trie.matchPrefix(text.data() + 1, text.data() + text.size()), 5);
+		compare(trie, naive, text);
+
+		trie.clear();
+		ensure("cleared", trie.empty());
+		trie.compile();
+		ensure_equals("find after clear", trie.find(text.data(), text.data() + text.size()), -1);
+	}
+
+	// Random patterns and texts, compared against the naive scan.
+	template<> template<>
+	void ahocorasick_object_t::test<4>()
+	{
+		static const char narrow[] = { 'a', 'b', 'c' };
+		compareRandom(narrow, sizeof(narrow), 1);
+		// Characters outside the ascii table of the root, and one that only differs in the high bits.
+		static const llwchar wide[] = { 'a', 'b', 0x4E2D, 0x1F600, 0x10061 };
+		compareRandom(wide, sizeof(wide) / sizeof(wide[0]), 2);
+	}
+}
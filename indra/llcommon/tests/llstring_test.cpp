@@ -0,0 +1,258 @@
+/**
+ * @file llstring_test.cpp
+ * @brief Checks the UTF-8 / UTF-32 conversions against a plain per character implementation.
+ *
+ * $LicenseInfo:firstyear=2013&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * $/LicenseInfo$
+ */
+
+#include "../linden_common.h"
+// Class to test
+#include "../llstring.h"
+// Tut header
+#include "../test/lltut.h"
+
+namespace tut
+{
+	struct string_test
+	{
+		// The conversion as it was before the ascii runs were copied in blocks:
+		// one character at a time, including the handling of malformed input.
+		LLWString scalar_utf8str_to_wstring(const std::string& utf8str, S32 len)
+		{
+			LLWString wout;
+			S32 i = 0;
+			while (i < len)
+			{
+				llwchar unichar;
+				U8 cur_char = utf8str[i];
+				if (cur_char < 0x80)
+				{
+					unichar = cur_char;
+				}
+				else
+				{
+					S32 cont_bytes = 0;
+					if ((cur_char >> 5) == 0x6)
+					{
+						unichar = (0x1F&cur_char);
+						cont_bytes = 1;
+					}
+					else if ((cur_char >> 4) == 0xe)
+					{
+						unichar = (0x0F&cur_char);
+						cont_bytes = 2;
+					}
+					else if ((cur_char >> 3) == 0x1e)
+					{
+						unichar = (0x07&cur_char);
+						cont_bytes = 3;
+					}
+					else if ((cur_char >> 2) == 0x3e)
+					{
+						unichar = (0x03&cur_char);
+						cont_bytes = 4;
+					}
+					else if ((cur_char >> 1) == 0x7e)
+					{
+						unichar = (0x01&cur_char);
+						cont_bytes = 5;
+					}
+					else
+					{
+						wout += LL_UNKNOWN_CHAR;
+						++i;
+						continue;
+					}
+					S32 end = (len < (i + cont_bytes)) ? len : (i + cont_bytes);
+					do
+					{
+						++i;
+						cur_char = utf8str[i];
+						if ((cur_char >> 6) == 0x2)
+						{
+							unichar <<= 6;
+							unichar += (0x3F&cur_char);
+						}
+						else
+						{
+							unichar = LL_UNKNOWN_CHAR;
+							--i;
+							break;
+						}
+					} while (i < end);
+					if (((cont_bytes == 1) && (unichar < 0x80))
+						|| ((cont_bytes == 2) && (unichar < 0x800))
+						|| ((cont_bytes == 3) && (unichar < 0x10000))
+						|| ((cont_bytes == 4) && (unichar < 0x200000))
+						|| ((cont_bytes == 5) && (unichar < 0x4000000)))
+					{
+						unichar = LL_UNKNOWN_CHAR;
+					}
+				}
+				wout += unichar;
+				++i;
+			}
+			return wout;
+		}
+
+		// The conversion as it was before the ascii runs were copied in blocks.
+		// Appending tchars as a C string drops U+0000.
+		std::string scalar_wstring_to_utf8str(const LLWString& utf32str, S32 len)
+		{
+			std::string out;
+			S32 i = 0;
+			while (i < len)
+			{
+				char tchars[8];		/* Flawfinder: ignore */
+				S32 n = wchar_to_utf8chars(utf32str[i], tchars);
+				tchars[n] = 0;
+				out += tchars;
+				i++;
+			}
+			return out;
+		}
+
+		// Ascii text that doesn't repeat every 16 bytes.
+		std::string ascii(S32 length, S32 seed)
+		{
+			std::string result;
+			for (S32 i = 0; i < length; ++i)
+			{
+				result += (char)(' ' + (seed + i * 7) % 95);
+			}
+			return result;
+		}
+
+		// Converts every prefix of str, so that runs end at every possible offset.
+		void checkUTF8(const std::string& str, bool valid)
+		{
+			for (S32 len = 0; len <= (S32)str.size(); ++len)
+			{
+				LLWString wstr = utf8str_to_wstring(str, len);
+				ensure("utf8str_to_wstring matches the scalar conversion", wstr == scalar_utf8str_to_wstring(str, len));
+				if (valid && len == (S32)str.size())
+				{
+					ensure("round trip", wstring_to_utf8str(wstr) == str);
+				}
+			}
+		}
+
+		void checkUTF32(const LLWString& wstr)
+		{
+			for (S32 len = 0; len <= (S32)wstr.size(); ++len)
+			{
+				ensure("wstring_to_utf8str matches the scalar conversion", wstring_to_utf8str(wstr, len) == scalar_wstring_to_utf8str(wstr, len));
+			}
+		}
+	};
+	typedef test_group<string_test> string_t;
+	typedef string_t::object string_object_t;
+	tut::string_t tut_string("LLString");
+
+	// Ascii runs of every length around the block size.
+	template<> template<>
+	void string_object_t::test<1>()
+	{
+		for (S32 length = 0; length <= 50; ++length)
+		{
+			std::string str = ascii(length, length);
+			checkUTF8(str, true);
+			LLWString wstr = utf8str_to_wstring(str);
+			ensure_equals("one character per byte", wstr.size(), str.size());
+			checkUTF32(wstr);
+		}
+	}
+
+	// Multibyte and malformed sequences at every offset around a block boundary.
+	template<> template<>
+	void string_object_t::test<2>()
+	{
+		struct Sequence
+		{
+			const char* mBytes;
+			bool mValid;
+		};
+		Sequence const sequences[] = {
+			{ "\xC3\xA9", true },					// U+00E9
+			{ "\xE2\x82\xAC", true },				// U+20AC
+			{ "\xF0\x9F\x98\x80", true },			// U+1F600
+			{ "\xC3\xA9\xE2\x82\xAC", true },		// Two in a row
+			{ "\x80", false },						// Stray continuation byte
+			{ "\xBF\xBF", false },
+			{ "\xC3", false },						// Truncated
+			{ "\xE2\x82", false },
+			{ "\xF0\x9F\x98", false },
+			{ "\xC0\x80", false },					// Overlong NUL
+			{ "\xE0\x80\xAF", false },				// Overlong '/'
+			{ "\xF8\x88\x80\x80\x80", false },		// Five bytes
+			{ "\xFE", false },
+			{ "\xFF", false },
+		};
+		for (size_t s = 0; s < sizeof(sequences) / sizeof(sequences[0]); ++s)
+		{
+			for (S32 prefix = 0; prefix <= 34; ++prefix)
+			{
+				static S32 const suffixes[] = { 0, 1, 15, 16, 17, 40 };
+				for (size_t n = 0; n < sizeof(suffixes) / sizeof(suffixes[0]); ++n)
+				{
+					std::string str = ascii(prefix, (S32)s) + sequences[s].mBytes + ascii(suffixes[n], prefix);
+					checkUTF8(str, sequences[s].mValid);
+				}
+			}
+		}
+	}
+
+	// Non-ascii characters, including invalid ones, at every offset around a block boundary.
+	template<> template<>
+	void string_object_t::test<3>()
+	{
+		llwchar const chars[] = { 0, 0x7F, 0x80, 0xFF, 0x100, 0x7FF, 0x800, 0xFFFF, 0x10000, 0x10FFFF, 0x110000, 0x7FFFFFFF, 0x80000000, 0xFFFFFFFF };
+		for (size_t c = 0; c < sizeof(chars) / sizeof(chars[0]); ++c)
+		{
+			for (S32 prefix = 0; prefix <= 18; ++prefix)
+			{
+				LLWString wstr = utf8str_to_wstring(ascii(prefix, prefix));
+				wstr += chars[c];
+				wstr += utf8str_to_wstring(ascii(18 - prefix, (S32)c));
+				checkUTF32(wstr);
+			}
+		}
+	}
+
+	// Embedded NULs: kept from UTF-8, dropped when converting to UTF-8.
+	template<> template<>
+	void string_object_t::test<4>()
+	{
+		for (S32 prefix = 0; prefix <= 18; ++prefix)
+		{
+			std::string str = ascii(prefix, prefix);
+			str += '\0';
+			str += ascii(18 - prefix, 3);
+			checkUTF8(str, false);
+			LLWString wstr = utf8str_to_wstring(str);
+			ensure_equals("NUL decoded", wstr.size(), str.size());
+			ensure_equals("NUL decoded as U+0000", wstr[prefix], (llwchar)0);
+			checkUTF32(wstr);
+			std::string out = wstring_to_utf8str(wstr);
+			ensure("NUL dropped", out == ascii(prefix, prefix) + ascii(18 - prefix, 3));
+		}
+		LLWString nuls(20, 0);
+		ensure("only NULs", wstring_to_utf8str(nuls).empty());
+	}
+}
@@ -0,0 +1,161 @@
+/**
+ * @file llstringtable_test.cpp
+ * @brief Checks LLStringTable, also while it is used from several threads at once.
+ *
+ * $LicenseInfo:firstyear=2013&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * $/LicenseInfo$
+ */
+
+#include "../linden_common.h"
+#include <vector>
+#include "../llthread.h"
+#include "../lltimer.h"
+// Class to test
+#include "../llstringtable.h"
+// Tut header
+#include "../test/lltut.h"
+
+namespace tut
+{
+	static const S32 SHARED_STRINGS = 200;
+	static const S32 ROUNDS = 100;
+	static const S32 THREADS = 8;
+
+	// Every thread adds the same shared strings, and adds and removes strings of its own,
+	// all in a table with few buckets so that the threads walk the same chains.
+	class StringTableThread : public LLThread
+	{
+	public:
+		StringTableThread(LLStringTable& table, S32 index) :
+			LLThread("LLStringTable test"), mTable(table), mIndex(index), mFailures(0) { }
+
+		/*virtual*/ void run()
+		{
+			for (S32 round = 0; round < ROUNDS; ++round)
+			{
+				for (S32 i = 0; i < SHARED_STRINGS; ++i)
+				{
+					char* shared = mTable.addString(llformat("shared string %d", i));
+					if (round == 0)
+					{
+						mShared.push_back(shared);
+					}
+					else if (shared != mShared[i])
+					{
+						++mFailures;
+					}
+				}
+				std::string own = llformat("thread %d round %d", mIndex, round);
+				char* added = mTable.addString(own);
+				if (!added || own != added || mTable.checkString(own) != added)
+				{
+					++mFailures;
+				}
+				mTable.removeString(own.c_str());
+				if (mTable.checkString(own))
+				{
+					++mFailures;
+				}
+			}
+		}
+
+		LLStringTable& mTable;
+		S32 mIndex;
+		S32 mFailures;
+		std::vector<char*> mShared;
+	};
+
+	struct stringtable_test
+	{
+	};
+	typedef test_group<stringtable_test> stringtable_t;
+	typedef stringtable_t::object stringtable_object_t;
+	tut::stringtable_t tut_stringtable("LLStringTable");
+
+	// add, check and reference counted remove.
+	template<> template<>
+	void stringtable_object_t::test<1>()
+	{
+		LLStringTable table(0);
+		ensure("NULL", table.addString((const char*)NULL) == NULL && table.checkString((const char*)NULL) == NULL);
+
+		char* hello = table.addString("hello");
+		ensure("added", hello && !strcmp(hello, "hello"));
+		ensure("added twice", table.addString(std::string("hello")) == hello);
+		ensure("check", table.checkString("hello") == hello && table.checkStringEntry("hello")->mString == hello);
+		ensure("check missing", table.checkString("world") == NULL);
+		ensure_equals("unique entries", table.mUniqueEntries, 1);
+
+		table.removeString("hello");
+		ensure("still referenced once", table.checkString("hello") == hello);
+		table.removeString("hello");
+		ensure("removed", table.checkString("hello") == NULL);
+		ensure_equals("no unique entries", table.mUniqueEntries, 0);
+		ensure("removed string stays valid", !strcmp(hello, "hello"));
+		table.removeString("world");	// Not in the table: ignored.
+
+		char* again = table.addString("hello");
+		ensure("added again", again && !strcmp(again, "hello") && table.checkString("hello") == again);
+
+		// Only the first MAX_STRINGS_LENGTH - 1 characters are stored and compared.
+		std::string long_string(MAX_STRINGS_LENGTH + 10, 'x');
+		char* truncated = table.addString(long_string);
+		ensure_equals("truncated", strlen(truncated), (size_t)(MAX_STRINGS_LENGTH - 1));
+		ensure("same prefix", table.checkString(long_string + "y") == truncated);
+	}
+
+	// Concurrent adds, lookups and removes.
+	template<> template<>
+	void stringtable_object_t::test<2>()
+	{
+		LLStringTable table(16);
+		std::vector<StringTableThread*> threads;
+		for (S32 i = 0; i < THREADS; ++i)
+		{
+			threads.push_back(new StringTableThread(table, i));
+		}
+		for (S32 i = 0; i < THREADS; ++i)
+		{
+			threads[i]->start();
+		}
+		for (S32 i = 0; i < THREADS; ++i)
+		{
+			while (!threads[i]->isStopped())
+			{
+				ms_sleep(1);
+			}
+		}
+
+		for (S32 i = 0; i < THREADS; ++i)
+		{
+			ensure_equals("failures", threads[i]->mFailures, 0);
+			ensure("all threads share the same entries", threads[i]->mShared == threads[0]->mShared);
+		}
+		ensure_equals("unique entries", table.mUniqueEntries, SHARED_STRINGS);
+		for (S32 i = 0; i < SHARED_STRINGS; ++i)
+		{
+			std::string shared = llformat("shared string %d", i);
+			ensure("shared string", table.checkString(shared) == threads[0]->mShared[i] && shared == threads[0]->mShared[i]);
+		}
+		for (S32 i = 0; i < THREADS; ++i)
+		{
+			ensure("own strings removed", table.checkString(llformat("thread %d round %d", i, ROUNDS - 1)) == NULL);
+			delete threads[i];
+		}
+	}
+}
@@ -0,0 +1,220 @@
+/**
+ * @file lluuidhashmap_test.cpp
+ * @brief Checks LLUUIDHashMap and LLUUIDHashSet against std::map and std::set.
+ *
+ * $LicenseInfo:firstyear=2013&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * $/LicenseInfo$
+ */
+
+#include "../linden_common.h"
+#include <map>
+#include <set>
+#include <vector>
+// Class to test
+#include "../lluuidhashmap.h"
+// Tut header
+#include "../test/lltut.h"
+
+namespace tut
+{
+	struct uuidhashmap_test
+	{
+		// ll_uuid_hash() of the returned id is lo ^ hi, so tests can choose the home slot.
+		LLUUID makeKey(U64 lo, U64 hi)
+		{
+			LLUUID id;
+			memcpy(id.mData, &lo, sizeof(U64));
+			memcpy(id.mData + sizeof(U64), &hi, sizeof(U64));
+			return id;
+		}
+
+		// Deterministic pseudo random ids.
+		LLUUID randomKey(U64& seed)
+		{
+			seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+			U64 lo = seed;
+			seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+			return makeKey(lo, seed);
+		}
+
+		template <class MAP>
+		size_t countByIteration(const MAP& map)
+		{
+			size_t count = 0;
+			for (typename MAP::const_iterator iter = map.begin(); iter != map.end(); ++iter)
+			{
+				++count;
+			}
+			return count;
+		}
+	};
+	typedef test_group<uuidhashmap_test> uuidhashmap_t;
+	typedef uuidhashmap_t::object uuidhashmap_object_t;
+	tut::uuidhashmap_t tut_uuidhashmap("LLUUIDHashMap");
+
+	// insert, operator[], find and count.
+	template<> template<>
+	void uuidhashmap_object_t::test<1>()
+	{
+		LLUUIDHashMap<S32> map;
+		ensure("new map is empty", map.empty() && map.begin() == map.end());
+		ensure("find in empty map", map.find(LLUUID::null) == map.end());
+
+		U64 seed = 1;
+		std::vector<LLUUID> ids;
+		for (S32 i = 0; i < 1000; ++i)
+		{
+			ids.push_back(randomKey(seed));
+			if (i % 2)
+			{
+				map[ids.back()] = i;
+			}
+			else
+			{
+				ensure("insert new", map.insert(std::make_pair(ids.back(), i)).second);
+			}
+		}
+		ensure_equals("size", map.size(), (size_t)1000);
+		ensure_equals("iteration", countByIteration(map), (size_t)1000);
+
+		ensure("insert existing", !map.insert(std::make_pair(ids[10], -1)).second);
+		ensure_equals("insert existing keeps value", map[ids[10]], 10);
+		map[ids[11]] = -11;
+		ensure_equals("operator[] overwrites", map.find(ids[11])->second, -11);
+		ensure_equals("size unchanged", map.size(), (size_t)1000);
+
+		for (S32 i = 0; i < 1000; ++i)
+		{
+			if (i != 11)
+			{
+				LLUUIDHashMap<S32>::const_iterator iter = map.find(ids[i]);
+				ensure("find", iter != map.end() && iter->first == ids[i] && iter->second == i);
+			}
+		}
+		ensure_equals("count missing", map.count(randomKey(seed)), (size_t)0);
+	}
+
+	// Backward shift deletion within a cluster that wraps around the end of the table.
+	template<> template<>
+	void uuidhashmap_object_t::test<2>()
+	{
+		LLUUIDHashMap<S32> map;
+		map.reserve(4);		// 16 slots, so the home slot of makeKey(n, 0) is n % 16.
+		// Homes 14, 14, 15, 14, 0, 15, 4: fills slots 14 through 4. The last element
+		// is in its home slot and must not be moved back when an element before it is erased.
+		U64 const homes[] = { 14, 14 + 16, 15, 14 + 32, 0, 15 + 16, 4 };
+		S32 const count = sizeof(homes) / sizeof(homes[0]);
+		std::vector<LLUUID> ids;
+		for (S32 i = 0; i < count; ++i)
+		{
+			ids.push_back(makeKey(homes[i], 0));
+			map[ids[i]] = i;
+		}
+
+		// Erase in an order that hits the start, the wrap and the middle of the cluster.
+		S32 const order[] = { 0, 4, 2, 6, 5, 1, 3 };
+		std::set<S32> erased;
+		for (S32 n = 0; n < count; ++n)
+		{
+			ensure_equals("erase", map.erase(ids[order[n]]), (size_t)1);
+			ensure_equals("erase twice", map.erase(ids[order[n]]), (size_t)0);
+			erased.insert(order[n]);
+			for (S32 i = 0; i < count; ++i)
+			{
+				bool found = map.find(ids[i]) != map.end();
+				ensure("remaining elements are still found", found == !erased.count(i));
+				if (found)
+				{
+					ensure_equals("value moved along", map[ids[i]], i);
+				}
+			}
+			ensure_equals("size", map.size(), (size_t)(count - n - 1));
+			ensure_equals("iteration", countByIteration(map), map.size());
+		}
+		ensure("empty", map.empty());
+	}
+
+	// Random inserts and erases, checked against std::map.
+	template<> template<>
+	void uuidhashmap_object_t::test<3>()
+	{
+		LLUUIDHashMap<U32> map;
+		std::map<LLUUID, U32> reference;
+		U64 seed = 42;
+		std::vector<LLUUID> ids;
+		for (S32 i = 0; i < 512; ++i)
+		{
+			// Only vary the lowest bits of the hash, so that ids end up in long clusters.
+			LLUUID id = randomKey(seed);
+			id.mData[0] &= 0x3f;
+			memset(id.mData + 1, 0, 7);
+			memset(id.mData + 8, 0, 8);
+			ids.push_back(id);
+		}
+		for (U32 step = 0; step < 20000; ++step)
+		{
+			seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+			LLUUID const& id = ids[(seed >> 33) % ids.size()];
+			if ((seed >> 20) & 1)
+			{
+				map[id] = step;
+				reference[id] = step;
+			}
+			else
+			{
+				ensure_equals("erase result", map.erase(id), reference.erase(id));
+			}
+		}
+		ensure_equals("size", map.size(), reference.size());
+		ensure_equals("iteration", countByIteration(map), reference.size());
+		for (std::vector<LLUUID>::iterator id = ids.begin(); id != ids.end(); ++id)
+		{
+			std::map<LLUUID, U32>::iterator expected = reference.find(*id);
+			LLUUIDHashMap<U32>::iterator found = map.find(*id);
+			ensure("same keys", (found == map.end()) == (expected == reference.end()));
+			if (expected != reference.end())
+			{
+				ensure_equals("same value", found->second, expected->second);
+			}
+		}
+
+		map.clear();
+		ensure("clear", map.empty() && map.begin() == map.end() && map.find(ids[0]) == map.end());
+	}
+
+	// LLUUIDHashSet
+	template<> template<>
+	void uuidhashmap_object_t::test<4>()
+	{
+		LLUUIDHashSet set;
+		U64 seed = 7;
+		LLUUID a = randomKey(seed);
+		LLUUID b = randomKey(seed);
+		ensure("insert new", set.insert(a).second);
+		ensure("insert existing", !set.insert(a).second);
+		ensure("insert another", set.insert(b).second);
+		ensure_equals("size", set.size(), (size_t)2);
+		ensure("found", *set.find(b) == b && set.count(a) == 1);
+		ensure_equals("erase", set.erase(a), (size_t)1);
+		ensure("erased", set.find(a) == set.end() && set.count(b) == 1);
+
+		LLUUIDHashSet other;
+		other.swap(set);
+		ensure("swap", set.empty() && other.size() == 1 && other.count(b) == 1);
+	}
+}
@@ -0,0 +1,357 @@
+/**
+ * @file llimagekernels.cpp
+ * @brief Pixel kernels used by LLImageBase/LLImageRaw resampling.
+ *
+ * $LicenseInfo:firstyear=2013&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "llimagekernels.h"
+#include "llmath.h"
+
+#if (_M_IX86_FP > 1 || defined(_M_X64) || defined(__SSE2__))
+#define LL_IMAGE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+//----------------------------------------------------------------------------
+// Mip generation
+
+static void avg4_colors4(const U8* a, const U8* b, const U8* c, const U8* d, U8* dst)
+{
+	dst[0] = (U8)(((U32)(a[0]) + b[0] + c[0] + d[0])>>2);
+	dst[1] = (U8)(((U32)(a[1]) + b[1] + c[1] + d[1])>>2);
+	dst[2] = (U8)(((U32)(a[2]) + b[2] + c[2] + d[2])>>2);
+	dst[3] = (U8)(((U32)(a[3]) + b[3] + c[3] + d[3])>>2);
+}
+
+static void avg4_colors3(const U8* a, const U8* b, const U8* c, const U8* d, U8* dst)
+{
+	dst[0] = (U8)(((U32)(a[0]) + b[0] + c[0] + d[0])>>2);
+	dst[1] = (U8)(((U32)(a[1]) + b[1] + c[1] + d[1])>>2);
+	dst[2] = (U8)(((U32)(a[2]) + b[2] + c[2] + d[2])>>2);
+}
+
+static void avg4_colors2(const U8* a, const U8* b, const U8* c, const U8* d, U8* dst)
+{
+	dst[0] = (U8)(((U32)(a[0]) + b[0] + c[0] + d[0])>>2);
+	dst[1] = (U8)(((U32)(a[1]) + b[1] + c[1] + d[1])>>2);
+}
+
+static void avg4_colors1(const U8* a, const U8* b, const U8* c, const U8* d, U8* dst)
+{
+	dst[0] = (U8)(((U32)(a[0]) + b[0] + c[0] + d[0])>>2);
+}
+
+// Reduces output pixels [first, width) of one row; row0 and row1 are the two
+// input rows that map onto it.
+static void mip_row_scalar(const U8* row0, const U8* row1, U8* out, S32 first, S32 width, S32 nchannels)
+{
+	void (*avg4)(const U8*, const U8*, const U8*, const U8*, U8*);
+	switch (nchannels)
+	{
+	  case 4:
+		avg4 = avg4_colors4;
+		break;
+	  case 3:
+		avg4 = avg4_colors3;
+		break;
+	  case 2:
+		avg4 = avg4_colors2;
+		break;
+	  case 1:
+		avg4 = avg4_colors1;
+		break;
+	  default:
+		llerrs << "generateMmip called with bad num channels" << llendl;
+		return;
+	}
+	for (S32 w = first; w < width; w++)
+	{
+		const S32 i = 2 * w * nchannels;
+		avg4(row0 + i, row0 + i + nchannels, row1 + i, row1 + i + nchannels, out + w * nchannels);
+	}
+}
+
+#if LL_IMAGE_SSE2
+// 16 input bytes from each of two rows (four RGBA pixels) -> two RGBA
+// pixels, as eight 16 bit lanes.
+static inline __m128i mip_rgba(__m128i a, __m128i b, __m128i zero)
+{
+	__m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));	// pixels 0, 1
+	__m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));	// pixels 2, 3
+	__m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));	// 0+1, 2+3
+	return _mm_srli_epi16(sum, 2);
+}
+
+// 16 input bytes from each of two rows -> eight single channel pixels, as
+// eight 16 bit lanes.
+static inline __m128i mip_alpha(__m128i a, __m128i b, __m128i zero, __m128i ones)
+{
+	__m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+	__m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+	// Add horizontal neighbours.
+	__m128i sum = _mm_packs_epi32(_mm_madd_epi16(lo, ones), _mm_madd_epi16(hi, ones));
+	return _mm_srli_epi16(sum, 2);
+}
+#endif
+
+void LLImageKernels::generateMip(const U8* indata, U8* mipdata, S32 width, S32 height, S32 nchannels)
+{
+	llassert(width > 0 && height > 0);
+#if LL_IMAGE_SSE2
+	if (nchannels == 4 || nchannels == 1)
+	{
+		const S32 in_row = 2 * width * nchannels;
+		const S32 out_row = width * nchannels;
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i ones = _mm_set1_epi16(1);
+		// Each step consumes 32 bytes of two input rows and writes 16 bytes.
+		const S32 step = 16 / nchannels;
+		for (S32 h = 0; h < height; h++)
+		{
+			const U8* row0 = indata + 2 * h * in_row;
+			const U8* row1 = row0 + in_row;
+			U8* out = mipdata + h * out_row;
+			S32 w = 0;
+			for (; w + step <= width; w += step)
+			{
+				const U8* p0 = row0 + 2 * w * nchannels;
+				const U8* p1 = row1 + 2 * w * nchannels;
+				__m128i a0 = _mm_loadu_si128((const __m128i*)p0);
+				__m128i a1 = _mm_loadu_si128((const __m128i*)(p0 + 16));
+				__m128i b0 = _mm_loadu_si128((const __m128i*)p1);
+				__m128i b1 = _mm_loadu_si128((const __m128i*)(p1 + 16));
+				__m128i result;
+				if (nchannels == 4)
+				{
+					result = _mm_packus_epi16(mip_rgba(a0, b0, zero), mip_rgba(a1, b1, zero));
+				}
+				else
+				{
+					result = _mm_packus_epi16(mip_alpha(a0, b0, zero, ones), mip_alpha(a1, b1, zero, ones));
+				}
+				_mm_storeu_si128((__m128i*)(out + w * nchannels), result);
+			}
+			mip_row_scalar(row0, row1, out, w, width, nchannels);
+		}
+		return;
+	}
+#endif
+	generateMipScalar(indata, mipdata, width, height, nchannels);
+}
+
+void LLImageKernels::generateMipScalar(const U8* indata, U8* mipdata, S32 width, S32 height, S32 nchannels)
+{
+	llassert(width > 0 && height > 0);
+	const S32 in_row = 2 * width * nchannels;
+	for (S32 h = 0; h < height; h++)
+	{
+		const U8* row0 = indata + 2 * h * in_row;
+		mip_row_scalar(row0, row0 + in_row, mipdata + h * width * nchannels, 0, width, nchannels);
+	}
+}
+
+//----------------------------------------------------------------------------
+// Line resampling
+
+#if LL_IMAGE_SSE2
+static inline __m128 load_rgba(const U8* p, __m128i zero)
+{
+	S32 pixel;
+	memcpy(&pixel, p, 4);
+	__m128i v = _mm_unpacklo_epi8(_mm_cvtsi32_si128(pixel), zero);
+	return _mm_cvtepi32_ps(_mm_unpacklo_epi16(v, zero));
+}
+
+// Four channel version of copyLineScaledScalar, doing all channels of a
+// pixel at once.
+static void copy_line_scaled_rgba(const U8* in, U8* out, S32 in_pixel_len, S32 out_pixel_len, S32 in_pixel_step, S32 out_pixel_step)
+{
+	const F32 ratio = F32(in_pixel_len) / out_pixel_len; // ratio of old to new
+	const __m128 norm_factor = _mm_set1_ps(1.f / ratio);
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128i zero = _mm_setzero_si128();
+	const S32 in_stride = in_pixel_step * 4;
+	const S32 out_stride = out_pixel_step * 4;
+
+	for (S32 x = 0; x < out_pixel_len; x++)
+	{
+		const F32 sample0 = x * ratio;
+		const F32 sample1 = (x+1) * ratio;
+		const S32 index0 = llfloor(sample0);
+		const S32 index1 = llfloor(sample1);
+		U8* outp = out + x * out_stride;
+
+		if (index0 == index1)
+		{
+			memcpy(outp, in + index0 * in_stride, 4);
+			continue;
+		}
+
+		const F32 fract0 = 1.f - (sample0 - F32(index0));
+		const F32 fract1 = sample1 - F32(index1);
+
+		__m128 sum = _mm_mul_ps(load_rgba(in + index0 * in_stride, zero), _mm_set1_ps(fract0));
+		for (S32 u = index0 + 1; u < index1; u++)
+		{
+			sum = _mm_add_ps(sum, load_rgba(in + u * in_stride, zero));
+		}
+		if (fract1 && index1 < in_pixel_len)
+		{
+			sum = _mm_add_ps(sum, _mm_mul_ps(load_rgba(in + index1 * in_stride, zero), _mm_set1_ps(fract1)));
+		}
+
+		// Values are non-negative, so truncating x + .5 rounds.
+		__m128i result = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(sum, norm_factor), half));
+		result = _mm_packs_epi32(result, result);
+		S32 pixel = _mm_cvtsi128_si32(_mm_packus_epi16(result, result));
+		memcpy(outp, &pixel, 4);
+	}
+}
+#endif
+
+void LLImageKernels::copyLineScaled(const U8* in, U8* out, S32 in_pixel_len, S32 out_pixel_len,
+									S32 in_pixel_step, S32 out_pixel_step, S32 components)
+{
+#if LL_IMAGE_SSE2
+	if (components == 4)
+	{
+		copy_line_scaled_rgba(in, out, in_pixel_len, out_pixel_len, in_pixel_step, out_pixel_step);
+		return;
+	}
+#endif
+	copyLineScaledScalar(in, out, in_pixel_len, out_pixel_len, in_pixel_step, out_pixel_step, components);
+}
+
+void LLImageKernels::copyLineScaledScalar(const U8* in, U8* out, S32 in_pixel_len, S32 out_pixel_len,
+										  S32 in_pixel_step, S32 out_pixel_step, S32 components)
+{
+	llassert( components >= 1 && components <= 4 );
+
+	const F32 ratio = F32(in_pixel_len) / out_pixel_len; // ratio of old to new
+	const F32 norm_factor = 1.f / ratio;
+
+	S32 goff = components >= 2 ? 1 : 0;
+	S32 boff = components >= 3 ? 2 : 0;
+	for( S32 x = 0; x < out_pixel_len; x++ )
+	{
+		// Sample input pixels in range from sample0 to sample1.
+		// Avoid floating point accumulation error... don't just add ratio each time.  JC
+		const F32 sample0 = x * ratio;
+		const F32 sample1 = (x+1) * ratio;
+		const S32 index0 = llfloor(sample0);			// left integer (floor)
+		const S32 index1 = llfloor(sample1);			// right integer (floor)
+		const F32 fract0 = 1.f - (sample0 - F32(index0));	// spill over on left
+		const F32 fract1 = sample1 - F32(index1);			// spill-over on right
+
+		if( index0 == index1 )
+		{
+			// Interval is embedded in one input pixel
+			S32 t0 = x * out_pixel_step * components;
+			S32 t1 = index0 * in_pixel_step * components;
+			U8* outp = out + t0;
+			const U8* inp = in + t1;
+			for (S32 i = 0; i < components; ++i)
+			{
+				*outp = *inp;
+				++outp;
+				++inp;
+			}
+		}
+		else
+		{
+			// Left straddle
+			S32 t1 = index0 * in_pixel_step * components;
+			F32 r = in[t1 + 0] * fract0;
+			F32 g = in[t1 + goff] * fract0;
+			F32 b = in[t1 + boff] * fract0;
+			F32 a = 0;
+			if( components == 4)
+			{
+				a = in[t1 + 3] * fract0;
+			}
+
+			// Central interval
+			if (components < 4)
+			{
+				for( S32 u = index0 + 1; u < index1; u++ )
+				{
+					S32 t2 = u * in_pixel_step * components;
+					r += in[t2 + 0];
+					g += in[t2 + goff];
+					b += in[t2 + boff];
+				}
+			}
+			else
+			{
+				for( S32 u = index0 + 1; u < index1; u++ )
+				{
+					S32 t2 = u * in_pixel_step * components;
+					r += in[t2 + 0];
+					g += in[t2 + 1];
+					b += in[t2 + 2];
+					a += in[t2 + 3];
+				}
+			}
+
+			// right straddle
+			// Watch out for reading off of end of input array.
+			if( fract1 && index1 < in_pixel_len )
+			{
+				S32 t3 = index1 * in_pixel_step * components;
+				if (components < 4)
+				{
+					U8 in0 = in[t3 + 0];
+					U8 in1 = in[t3 + goff];
+					U8 in2 = in[t3 + boff];
+					r += in0 * fract1;
+					g += in1 * fract1;
+					b += in2 * fract1;
+				}
+				else
+				{
+					U8 in0 = in[t3 + 0];
+					U8 in1 = in[t3 + 1];
+					U8 in2 = in[t3 + 2];
+					U8 in3 = in[t3 + 3];
+					r += in0 * fract1;
+					g += in1 * fract1;
+					b += in2 * fract1;
+					a += in3 * fract1;
+				}
+			}
+
+			r *= norm_factor;
+			g *= norm_factor;
+			b *= norm_factor;
+			a *= norm_factor;  // skip conditional
+
+			S32 t4 = x * out_pixel_step * components;
+			out[t4 + 0] = U8(llmath::llround(r));
+			if (components >= 2)
+				out[t4 + 1] = U8(llmath::llround(g));
+			if (components >= 3)
+				out[t4 + 2] = U8(llmath::llround(b));
+			if( components == 4)
+				out[t4 + 3] = U8(llmath::llround(a));
+		}
+	}
+}
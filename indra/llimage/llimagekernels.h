@@ -0,0 +1,50 @@
+/**
+ * @file llimagekernels.h
+ * @brief Pixel kernels used by LLImageBase/LLImageRaw resampling.
+ *
+ * $LicenseInfo:firstyear=2013&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLIMAGEKERNELS_H
+#define LL_LLIMAGEKERNELS_H
+
+#include "stdtypes.h"
+
+// Stateless inner loops of the image code, kept apart from LLImageRaw so
+// they can be vectorized (SSE2 when the compiler targets it) and tested on
+// their own. Every kernel has a plain C++ reference version that is used
+// for the pixel formats without a SIMD path.
+namespace LLImageKernels
+{
+	// Box filter a (2*width)x(2*height) image down to width x height.
+	// Bit exact with the scalar version for every channel count.
+	void generateMip(const U8* indata, U8* mipdata, S32 width, S32 height, S32 nchannels);
+	void generateMipScalar(const U8* indata, U8* mipdata, S32 width, S32 height, S32 nchannels);
+
+	// Area-average resample of one line of pixels. The steps are in pixels,
+	// so this works on rows (step 1) as well as columns (step = width).
+	// The SIMD version may differ from the scalar one by one unit where
+	// rounding lands exactly on .5.
+	void copyLineScaled(const U8* in, U8* out, S32 in_pixel_len, S32 out_pixel_len,
+						S32 in_pixel_step, S32 out_pixel_step, S32 components);
+	void copyLineScaledScalar(const U8* in, U8* out, S32 in_pixel_len, S32 out_pixel_len,
+							  S32 in_pixel_step, S32 out_pixel_step, S32 components);
+}
+
+#endif // LL_LLIMAGEKERNELS_H
@@ -0,0 +1,117 @@
+/**
+ * @file llimagekernels_test.cpp
+ * @brief Checks the vectorized image kernels against their scalar versions.
+ *
+ * $LicenseInfo:firstyear=2013&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * $/LicenseInfo$
+ */
+
+#include "../llcommon/linden_common.h"
+#include <vector>
+#include "../llmath/llmath.h"
+// Class to test
+#include "../llimagekernels.h"
+// Tut header
+#include "../test/lltut.h"
+
+namespace tut
+{
+	struct imagekernels_test
+	{
+		// Deterministic pseudo random pixel data, with some fully transparent
+		// and fully opaque runs thrown in.
+		void fill(std::vector<U8>& data, U32 seed)
+		{
+			for (size_t i = 0; i < data.size(); ++i)
+			{
+				seed = seed * 1103515245 + 12345;
+				U8 value = (U8)(seed >> 16);
+				if ((i / 64) % 4 == 1)
+				{
+					value = 0;
+				}
+				else if ((i / 64) % 4 == 2)
+				{
+					value = 255;
+				}
+				data[i] = value;
+			}
+		}
+
+		S32 maxDifference(const std::vector<U8>& a, const std::vector<U8>& b)
+		{
+			S32 result = 0;
+			for (size_t i = 0; i < a.size(); ++i)
+			{
+				result = llmax(result, llabs((S32)a[i] - (S32)b[i]));
+			}
+			return result;
+		}
+	};
+
+	typedef test_group<imagekernels_test> imagekernels_t;
+	typedef imagekernels_t::object imagekernels_object_t;
+	tut::imagekernels_t tut_imagekernels("imagekernels");
+
+	template<> template<>
+	void imagekernels_object_t::test<1>()
+	{
+		// generateMip must be bit exact, including widths that leave a scalar tail.
+		const S32 widths[] = { 1, 3, 4, 5, 16, 17, 33, 256 };
+		for (S32 channels = 1; channels <= 4; ++channels)
+		{
+			for (size_t w = 0; w < sizeof(widths) / sizeof(widths[0]); ++w)
+			{
+				const S32 width = widths[w];
+				const S32 height = 7;
+				std::vector<U8> in(width * 2 * height * 2 * channels);
+				fill(in, width * 31 + channels);
+				std::vector<U8> expected(width * height * channels);
+				std::vector<U8> result(width * height * channels);
+				LLImageKernels::generateMipScalar(&in[0], &expected[0], width, height, channels);
+				LLImageKernels::generateMip(&in[0], &result[0], width, height, channels);
+				ensure("generateMip differs from the scalar version", expected == result);
+			}
+		}
+	}
+
+	template<> template<>
+	void imagekernels_object_t::test<2>()
+	{
+		// copyLineScaled, up and down, on rows and on columns.
+		const S32 lengths[][2] = { { 256, 256 }, { 256, 100 }, { 100, 256 }, { 1024, 3 }, { 7, 512 }, { 333, 128 } };
+		for (S32 channels = 1; channels <= 4; ++channels)
+		{
+			for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); ++l)
+			{
+				const S32 in_len = lengths[l][0];
+				const S32 out_len = lengths[l][1];
+				for (S32 step = 1; step <= 3; step += 2)
+				{
+					std::vector<U8> in(in_len * step * channels);
+					fill(in, in_len + out_len + channels);
+					std::vector<U8> expected(out_len * step * channels);
+					std::vector<U8> result(out_len * step * channels);
+					LLImageKernels::copyLineScaledScalar(&in[0], &expected[0], in_len, out_len, step, step, channels);
+					LLImageKernels::copyLineScaled(&in[0], &result[0], in_len, out_len, step, step, channels);
+					ensure("copyLineScaled differs from the scalar version by more than rounding", maxDifference(expected, result) <= 1);
+				}
+			}
+		}
+	}
+}
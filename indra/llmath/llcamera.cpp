@@ -291,6 +291,81 @@ S32 LLCamera::AABBInRegionFrustumNoFarClip(const LLVector4a& center, const LLVec
 	return AABBInFrustumNoFarClip(center, radius, mRegionPlanes);
 }
 
+LLFrustum4a::LLFrustum4a(const LLCamera& camera, bool far_clip)
+{
+	LL_ALIGN_16(F32 plane[4][8]);
+	U32 max_planes = llmin(camera.mPlaneCount, (U32) LLCamera::AGENT_PLANE_USER_CLIP_NUM);
+	for (U32 i = 0; i < 8; i++)
+	{
+		if (i < max_planes && camera.mPlaneMask[i] < LLCamera::PLANE_MASK_NUM &&
+			(far_clip || i != LLCamera::AGENT_PLANE_FAR))
+		{
+			const LLPlane& p(camera.mAgentPlanes[i]);
+			for (U32 j = 0; j < 4; j++)
+			{
+				plane[j][i] = p[j];
+			}
+		}
+		else
+		{	//box is always on the inside
+			plane[0][i] = plane[1][i] = plane[2][i] = 0.f;
+			plane[3][i] = -1.f;
+		}
+	}
+
+	for (U32 i = 0; i < 2; i++)
+	{
+		mNormalX[i].load4a(plane[0] + 4 * i);
+		mNormalY[i].load4a(plane[1] + 4 * i);
+		mNormalZ[i].load4a(plane[2] + 4 * i);
+		mDist[i].load4a(plane[3] + 4 * i);
+		mAbsX[i].setAbs(mNormalX[i]);
+		mAbsY[i].setAbs(mNormalY[i]);
+		mAbsZ[i].setAbs(mNormalZ[i]);
+	}
+}
+
+S32 LLFrustum4a::AABBInFrustum(const LLVector4a& center, const LLVector4a& radius) const
+{
+	LLVector4a cx, cy, cz, rx, ry, rz;
+	cx.splat<0>(center);
+	cy.splat<1>(center);
+	cz.splat<2>(center);
+	rx.splat<0>(radius);
+	ry.splat<1>(radius);
+	rz.splat<2>(radius);
+
+	U32 partial = 0;
+	for (U32 i = 0; i < 2; i++)
+	{
+		// Signed distance of the box center to each plane, and how far the
+		// box reaches towards the planes (radius projected on the normal).
+		LLVector4a dist, reach, tmp;
+		dist.setMul(mNormalX[i], cx);
+		tmp.setMul(mNormalY[i], cy);
+		dist.add(tmp);
+		tmp.setMul(mNormalZ[i], cz);
+		dist.add(tmp);
+		dist.add(mDist[i]);
+
+		reach.setMul(mAbsX[i], rx);
+		tmp.setMul(mAbsY[i], ry);
+		reach.add(tmp);
+		tmp.setMul(mAbsZ[i], rz);
+		reach.add(tmp);
+
+		tmp.setSub(dist, reach);
+		if (tmp.greaterThan(LLVector4a::getZero()).getGatheredBits())
+		{	//nearest corner outside of a plane
+			return 0;
+		}
+		tmp.setAdd(dist, reach);
+		partial |= tmp.greaterThan(LLVector4a::getZero()).getGatheredBits();
+	}
+
+	return partial ? 1 : 2;
+}
+
 int LLCamera::sphereInFrustumQuick(const LLVector3 &sphere_center, const F32 radius) 
 {
 	LLVector3 dist = sphere_center-mFrustCenter;
@@ -64,6 +64,8 @@ LL_ALIGN_PREFIX(16)
 class LLCamera
 : 	public LLCoordFrame
 {
+	friend class LLFrustum4a;
+
 public:
 	
 	LLCamera(const LLCamera& rhs)
@@ -229,6 +231,31 @@ protected:
 	void calculateWorldFrustumPlanes();
 } LL_ALIGN_POSTFIX(16);
 
+// The agent frustum planes of a camera, transposed so that a box is tested
+// against four planes per SIMD operation instead of one. This is a snapshot:
+// build one per traversal, it doesn't follow changes to the camera.
+LL_ALIGN_PREFIX(16)
+class LLFrustum4a
+{
+public:
+	LLFrustum4a(const LLCamera& camera, bool far_clip = true);
+
+	// Same as LLCamera::AABBInFrustum (or AABBInFrustumNoFarClip when built
+	// without far_clip): 0 if out, 1 if partly in, 2 if fully in.
+	S32 AABBInFrustum(const LLVector4a& center, const LLVector4a& radius) const;
+
+private:
+	// Plane normals, their absolute values and distances, four planes per vector.
+	// Unused slots hold a plane every box is inside of.
+	LL_ALIGN_16(LLVector4a mNormalX[2]);
+	LL_ALIGN_16(LLVector4a mNormalY[2]);
+	LL_ALIGN_16(LLVector4a mNormalZ[2]);
+	LL_ALIGN_16(LLVector4a mAbsX[2]);
+	LL_ALIGN_16(LLVector4a mAbsY[2]);
+	LL_ALIGN_16(LLVector4a mAbsZ[2]);
+	LL_ALIGN_16(LLVector4a mDist[2]);
+} LL_ALIGN_POSTFIX(16);
+
 
 #endif
 
@@ -2374,7 +2374,25 @@ bool LLVolume::unpackVolumeFaces(std::istream& is, S32 size)
 		LL_DEBUGS("MeshStreaming") << "Failed to unzip LLSD blob for LoD, will probably fetch from sim again." << LL_ENDL;
 		return false;
 	}
-	
+
+	return unpackVolumeFacesInternal(mdl);
+}
+
+bool LLVolume::unpackVolumeFaces(const U8* data, S32 size)
+{
+	//data points at a zlib compressed block of LLSD, decompress it in place
+	LLSD mdl;
+	if (!unzip_llsd(mdl, data, size))
+	{
+		LL_DEBUGS("MeshStreaming") << "Failed to unzip LLSD blob for LoD, will probably fetch from sim again." << LL_ENDL;
+		return false;
+	}
+
+	return unpackVolumeFacesInternal(mdl);
+}
+
+bool LLVolume::unpackVolumeFacesInternal(const LLSD& mdl)
+{
 	{
 		U32 face_count = mdl.size();
 
@@ -2389,8 +2407,9 @@ bool LLVolume::unpackVolumeFaces(std::istream& is, S32 size)
 		for (U32 i = 0; i < face_count; ++i)
 		{
 			LLVolumeFace& face = mVolumeFaces[i];
+			const LLSD& face_sd = mdl[i];
 
-			if (mdl[i].has("NoGeometry"))
+			if (face_sd.has("NoGeometry"))
 			{ //face has no geometry, continue
 				face.resizeIndices(3);
 				face.resizeVertices(1);
@@ -2401,10 +2420,11 @@ bool LLVolume::unpackVolumeFaces(std::istream& is, S32 size)
 				continue;
 			}
 
-			LLSD::Binary pos = mdl[i]["Position"];
-			LLSD::Binary norm = mdl[i]["Normal"];
-			LLSD::Binary tc = mdl[i]["TexCoord0"];
-			LLSD::Binary idx = mdl[i]["TriangleList"];
+			// reference the decoded buffers directly instead of copying them
+			const LLSD::Binary& pos = face_sd["Position"].asBinaryRef();
+			const LLSD::Binary& norm = face_sd["Normal"].asBinaryRef();
+			const LLSD::Binary& tc = face_sd["TexCoord0"].asBinaryRef();
+			const LLSD::Binary& idx = face_sd["TriangleList"].asBinaryRef();
 
 			
 
@@ -2417,12 +2437,7 @@ bool LLVolume::unpackVolumeFaces(std::istream& is, S32 size)
 				continue;
 			}
 
-			U16* indices = (U16*) &(idx[0]);
-			U32 count = idx.size()/2;
-			for (U32 j = 0; j < count; ++j)
-			{
-				face.mIndices[j] = indices[j];
-			}
+			memcpy(face.mIndices, &(idx[0]), face.mNumIndices*sizeof(U16));
 
 			//copy out vertices
 			U32 num_verts = pos.size()/(3*2);
@@ -2433,14 +2448,14 @@ bool LLVolume::unpackVolumeFaces(std::istream& is, S32 size)
 			LLVector2 min_tc; 
 			LLVector2 max_tc; 
 		
-			minp.setValue(mdl[i]["PositionDomain"]["Min"]);
-			maxp.setValue(mdl[i]["PositionDomain"]["Max"]);
+			minp.setValue(face_sd["PositionDomain"]["Min"]);
+			maxp.setValue(face_sd["PositionDomain"]["Max"]);
 			LLVector4a min_pos, max_pos;
 			min_pos.load3(minp.mV);
 			max_pos.load3(maxp.mV);
 
-			min_tc.setValue(mdl[i]["TexCoord0Domain"]["Min"]);
-			max_tc.setValue(mdl[i]["TexCoord0Domain"]["Max"]);
+			min_tc.setValue(face_sd["TexCoord0Domain"]["Min"]);
+			max_tc.setValue(face_sd["TexCoord0Domain"]["Max"]);
 
 			LLVector4a pos_range;
 			pos_range.setSub(max_pos, min_pos);
@@ -2453,8 +2468,9 @@ bool LLVolume::unpackVolumeFaces(std::istream& is, S32 size)
 			LLVector4a* norm_out = face.mNormals;
 			LLVector4a* tc_out = (LLVector4a*) face.mTexCoords;
 
+			if (!pos.empty())
 			{
-				U16* v = (U16*) &(pos[0]);
+				const U16* v = (const U16*) &(pos[0]);
 				for (U32 j = 0; j < num_verts; ++j)
 				{
 					pos_out->set((F32) v[0], (F32) v[1], (F32) v[2]);
@@ -2470,7 +2486,7 @@ bool LLVolume::unpackVolumeFaces(std::istream& is, S32 size)
 			{
 				if (!norm.empty())
 				{
-					U16* n = (U16*) &(norm[0]);
+					const U16* n = (const U16*) &(norm[0]);
 					for (U32 j = 0; j < num_verts; ++j)
 					{
 						norm_out->set((F32) n[0], (F32) n[1], (F32) n[2]);
@@ -2490,7 +2506,7 @@ bool LLVolume::unpackVolumeFaces(std::istream& is, S32 size)
 			{
 				if (!tc.empty())
 				{
-					U16* t = (U16*) &(tc[0]);
+					const U16* t = (const U16*) &(tc[0]);
 					for (U32 j = 0; j < num_verts; j+=2)
 					{
 						if (j < num_verts-1)
@@ -2517,11 +2533,11 @@ bool LLVolume::unpackVolumeFaces(std::istream& is, S32 size)
 				}
 			}
 
-			if (mdl[i].has("Weights"))
+			if (face_sd.has("Weights"))
 			{
 				face.allocateWeights(num_verts);
 
-				LLSD::Binary weights = mdl[i]["Weights"];
+				const LLSD::Binary& weights = face_sd["Weights"].asBinaryRef();
 
 				U32 idx = 0;
 
@@ -1062,8 +1062,10 @@ private:
 protected:
 	BOOL generate();
 	void createVolumeFaces();
+	bool unpackVolumeFacesInternal(const LLSD& mdl);
 public:
 	virtual bool unpackVolumeFaces(std::istream& is, S32 size);
+	bool unpackVolumeFaces(const U8* data, S32 size);
 
 	virtual void setMeshAssetLoaded(BOOL loaded);
 	virtual BOOL isMeshAssetLoaded();
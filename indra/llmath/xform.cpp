@@ -90,9 +90,13 @@ void LLXformMatrix::updateMatrix(BOOL update_bounds)
 {
 	update();
 
-	LLMatrix4 world_matrix;
-	world_matrix.initAll(mScale, mWorldRotation, mWorldPosition);
-	mWorldMatrix.loadu(world_matrix);
+	// Build scale * rotation * translation directly in SSE registers
+	// rather than composing an LLMatrix4 and loading it.
+	mWorldMatrix = LLMatrix4a(LLQuaternion2(mWorldRotation));
+	mWorldMatrix.applyScale_affine(mScale);
+	LLVector4a translation;
+	translation.load3(mWorldPosition.mV, 1.f);
+	mWorldMatrix.setRow<LLMatrix4a::ROW_TRANS>(translation);
 
 	if (update_bounds && (mChanged & MOVED))
 	{
@@ -50,6 +50,7 @@
 #include "aicurl.h"
 #include "llbufferstream.h"
 #include "llsdserialize.h"
+#include "llfile.h"
 #include "aithreadsafe.h"
 #include "llqueuedthread.h"
 #include "llproxy.h"
@@ -466,6 +467,25 @@ U32 getNumHTTPRunning(void)
   return Stats::running_handles;
 }
 
+// THREAD-SAFE
+LLSD getHTTPTimingStats(void)
+{
+  return AIPerService::getAllTimingStats();
+}
+
+// MAIN-THREAD
+void writeHTTPTimingStats(std::string const& filename)
+{
+  llofstream out(filename);
+  if (!out.is_open())
+  {
+	llwarns << "Could not open " << filename << " for writing." << llendl;
+	return;
+  }
+  LLSDSerialize::toPrettyXML(getHTTPTimingStats(), out);
+  llinfos << "Wrote HTTP timing statistics to " << filename << llendl;
+}
+
 //static
 void Stats::print(void)
 {
@@ -1219,6 +1239,30 @@ void CurlEasyRequest::print_curl_timings(void) const
   DoutCurl("CURLINFO_STARTTRANSFER_TIME = " << t);
 }
 
+void CurlEasyRequest::getTimings(AICurlTimings& timings) const
+{
+  // All of these are the time since the start of the request.
+  double namelookup, connect, appconnect, pretransfer, starttransfer, total;
+  long new_connections;
+  getinfo(CURLINFO_NAMELOOKUP_TIME, &namelookup);
+  getinfo(CURLINFO_CONNECT_TIME, &connect);
+  getinfo(CURLINFO_APPCONNECT_TIME, &appconnect);
+  getinfo(CURLINFO_PRETRANSFER_TIME, &pretransfer);
+  getinfo(CURLINFO_STARTTRANSFER_TIME, &starttransfer);
+  getinfo(CURLINFO_TOTAL_TIME, &total);
+  getinfo(CURLINFO_NUM_CONNECTS, &new_connections);
+  // APPCONNECT_TIME is zero when no SSL handshake took place.
+  double const connected = llmax(connect, appconnect);
+  timings.phase[AICurlTimings::dns] = (U32)(1000 * namelookup);
+  timings.phase[AICurlTimings::connect] = (U32)(1000 * llmax(connect - namelookup, 0.0));
+  timings.phase[AICurlTimings::tls] = (U32)(1000 * llmax(connected - connect, 0.0));
+  timings.phase[AICurlTimings::wait] = (U32)(1000 * llmax(starttransfer - llmax(pretransfer, connected), 0.0));
+  timings.phase[AICurlTimings::transfer] = (U32)(1000 * llmax(total - starttransfer, 0.0));
+  timings.time_to_first_byte = (F32)starttransfer;
+  timings.reused_connection = new_connections == 0;
+  timings.valid = true;
+}
+
 void CurlEasyRequest::getTransferInfo(AITransferInfo* info)
 {
   // Curl explicitly demands a double for these info's.
@@ -204,6 +204,14 @@ U32 getMaxHTTPAdded(void);
 // Returns the number of active curl easy handles (that are actually attempting to download something).
 U32 getNumHTTPRunning(void);
 
+// Returns the curl timing statistics of all services as an LLSD map with the service names (hostname:port) as keys.
+// Each value is a map with histograms (in ms) of the timing phases dns, connect, tls, wait and transfer,
+// a histogram of the number of requests in flight, and the connection reuse counts.
+LLSD getHTTPTimingStats(void);
+
+// Called from newview/llappviewer.cpp upon exit to write the result of getHTTPTimingStats() to filename (as XML).
+void writeHTTPTimingStats(std::string const& filename);
+
 // Cache for gSavedSettings so we have access from llmessage.
 extern LLControlGroup* sConfigGroup;
 
@@ -40,6 +40,7 @@
 #include "aicurlperservice.h"
 #include "aicurlthread.h"
 #include "llcontrol.h"
+#include "llsd.h"
 
 AIPerService::threadsafe_instance_map_type AIPerService::sInstanceMap;
 AIThreadSafeSimpleDC<AIPerService::TotalQueued> AIPerService::sTotalQueued;
@@ -77,6 +78,10 @@ AIPerService::AIPerService(void) :
 		mTotalAdded(0),
 		mEventPolls(0),
 		mEstablishedConnections(0),
+		mNewConnections(0),
+		mReusedConnections(0),
+		mConsoleNewConnections(0),
+		mConsoleReusedConnections(0),
 		mUsedCT(0),
 		mCTInUse(0)
 {
@@ -89,7 +94,11 @@ AIPerService::CapabilityType::CapabilityType(void) :
 		mFlags(0),
 		mDownloading(0),
 		mMaxPipelinedRequests(CurlConcurrentConnectionsPerService),
-		mConcurrentConnections(CurlConcurrentConnectionsPerService)
+		mConcurrentConnections(CurlConcurrentConnectionsPerService),
+		mAdaptiveConnections(CurlConcurrentConnectionsPerService),
+		mAdaptiveWindow(0),
+		mWindowCongested(false),
+		mBaseLatency(0.f)
 {
 }
 
@@ -97,6 +106,49 @@ AIPerService::CapabilityType::~CapabilityType()
 {
 }
 
+// Additive increase, multiplicative decrease of the number of connections that this capability type may use.
+//
+// A request is considered congested when it timed out or the server told us it's overloaded,
+// or when the time to the first byte exceeds four times the (slowly rising) minimum that we saw.
+// Once a full window (connection_limit() requests) finished, the limit is halved if any request
+// of that window was congested, and otherwise one more connection is allowed. Waiting for a
+// full window makes sure we react at most once per round trip.
+void AIPerService::CapabilityType::adapt_concurrency(bool congested, F32 time_to_first_byte)
+{
+  if (time_to_first_byte > 0.f)
+  {
+	if (mBaseLatency == 0.f || time_to_first_byte < mBaseLatency)
+	{
+	  mBaseLatency = time_to_first_byte;
+	}
+	else
+	{
+	  // Let the base latency slowly follow the real latency up, so that a single lucky request doesn't throttle us forever.
+	  mBaseLatency += (time_to_first_byte - mBaseLatency) / 64;
+	  congested = congested || time_to_first_byte > 4 * mBaseLatency + 0.05f;
+	}
+  }
+  mWindowCongested = mWindowCongested || congested;
+  U16 const limit = connection_limit();
+  if (++mAdaptiveWindow < limit)
+  {
+	return;
+  }
+  if (mWindowCongested)
+  {
+	mAdaptiveConnections = llmax(limit / 2, 1);
+  }
+  else if (mAdaptiveConnections < mConcurrentConnections)
+  {
+	// Note that mAdaptiveConnections is not clamped when redivide_connections gives us more connections,
+	// so that new connections can be used immediately unless we saw congestion before.
+	mAdaptiveConnections = limit + 1;
+  }
+  // Always start a new window, also when we're already at mConcurrentConnections (otherwise mAdaptiveWindow would wrap around).
+  mAdaptiveWindow = 0;
+  mWindowCongested = false;
+}
+
 // Fake copy constructor.
 AIPerService::AIPerService(AIPerService const&) : mHTTPBandwidth(0)
 {
@@ -333,7 +385,7 @@ void AIPerService::redivide_connections(void)
 bool AIPerService::throttled(AICapabilityType capability_type) const
 {
   return mTotalAdded >= mConcurrentConnections ||
-		 mCapabilityType[capability_type].mAdded >= mCapabilityType[capability_type].mConcurrentConnections;
+		 mCapabilityType[capability_type].mAdded >= mCapabilityType[capability_type].connection_limit();
 }
 
 void AIPerService::added_to_multi_handle(AICapabilityType capability_type, bool event_poll)
@@ -381,8 +433,29 @@ void AIPerService::added_to_multi_handle(AICapabilityType capability_type, bool
   ++mTotalAdded;
 }
 
-void AIPerService::removed_from_multi_handle(AICapabilityType capability_type, bool event_poll, bool downloaded_something, bool success)
+void AIPerService::removed_from_multi_handle(AICapabilityType capability_type, bool event_poll, bool downloaded_something, bool success,
+											 bool congested, AICurlTimings const& timings)
 {
+  if (timings.valid && !event_poll)
+  {
+	for (int phase = 0; phase < AICurlTimings::number_of_phases; ++phase)
+	{
+	  mPhaseTimes[phase].add(timings.phase[phase]);
+	}
+	mInFlight.add(mTotalAdded);
+	mConsoleWaitTimes.add(timings.phase[AICurlTimings::wait]);
+	mConsoleTransferTimes.add(timings.phase[AICurlTimings::transfer]);
+	if (timings.reused_connection)
+	{
+	  ++mReusedConnections;
+	  ++mConsoleReusedConnections;
+	}
+	else
+	{
+	  ++mNewConnections;
+	  ++mConsoleNewConnections;
+	}
+  }
   CapabilityType& ct(mCapabilityType[capability_type]);
   llassert(mTotalAdded > 0 && ct.mAdded > 0 && (!event_poll || mEventPolls));
   if (!event_poll || --mEventPolls == 0)
@@ -407,6 +480,10 @@ void AIPerService::removed_from_multi_handle(AICapabilityType capability_type, b
   {
 	ct.mFlags |= ctf_success;
   }
+  if (!event_poll)
+  {
+	ct.adapt_concurrency(congested, timings.time_to_first_byte);
+  }
 }
 
 // Returns true if the request was queued.
@@ -490,7 +567,7 @@ void AIPerService::add_queued_to(curlthread::MultiHandle* multi_handle, bool onl
 	  // We hit the maximum number of connections for this service. Abort any attempt to add anything to this service.
 	  break;
 	}
-	if (ct.mAdded >= ct.mConcurrentConnections)
+	if (ct.mAdded >= ct.connection_limit())
 	{
 	  // We hit the maximum number of connections for this capability type. Try the next one.
 	  continue;
@@ -638,11 +715,53 @@ void AIPerService::adjust_concurrent_connections(int increment)
   }
 }
 
+static char const* const phase_names[AICurlTimings::number_of_phases] = { "dns", "connect", "tls", "wait", "transfer" };
+
+LLSD AIPerService::getTimingStats(void) const
+{
+  LLSD stats;
+  for (int phase = 0; phase < AICurlTimings::number_of_phases; ++phase)
+  {
+	stats[phase_names[phase]] = mPhaseTimes[phase].asLLSD();
+  }
+  stats["in_flight"] = mInFlight.asLLSD();
+  stats["new_connections"] = (LLSD::Integer)mNewConnections;
+  stats["reused_connections"] = (LLSD::Integer)mReusedConnections;
+  U32 const finished = mNewConnections + mReusedConnections;
+  stats["reuse_ratio"] = finished ? (LLSD::Real)mReusedConnections / finished : 0.0;
+  return stats;
+}
+
+void AIPerService::resetConsoleStats(void)
+{
+  mConsoleWaitTimes.reset();
+  mConsoleTransferTimes.reset();
+  mConsoleNewConnections = 0;
+  mConsoleReusedConnections = 0;
+}
+
+//static
+LLSD AIPerService::getAllTimingStats(void)
+{
+  LLSD stats = LLSD::emptyMap();
+  instance_map_rat instance_map_r(sInstanceMap);
+  for (AIPerService::const_iterator iter = instance_map_r->begin(); iter != instance_map_r->end(); ++iter)
+  {
+	stats[iter->first] = PerService_rat(*iter->second)->getTimingStats();
+  }
+  return stats;
+}
+
 void AIPerService::ResetUsed::operator()(AIPerService::instance_map_type::value_type const& service) const
 {
   PerService_wat(*service.second)->resetUsedCt();
 }
 
+void AIPerService::ResetConsoleStats::operator()(AIPerService::instance_map_type::value_type const& service) const
+{
+  PerService_wat(*service.second)->resetConsoleStats();
+}
+
 void AIPerService::Approvement::honored(void)
 {
   if (!mHonored)
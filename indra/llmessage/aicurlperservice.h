@@ -40,6 +40,7 @@
 #define AICURLPERSERVICE_H
 
 #include "llerror.h"		// llassert
+#include "lldefs.h"		// llmin
 #include <string>
 #include <deque>
 #include <map>
@@ -48,6 +49,7 @@
 #include <boost/intrusive_ptr.hpp>
 #include "aithreadsafe.h"
 #include "aiaverage.h"
+#include "aihistogram.h"
 
 class AICurlEasyRequest;
 class AIPerService;
@@ -89,6 +91,24 @@ enum AICapabilityType {		// {Capabilities} [Responders]
 
 static U32 const approved_mask = 3;		// The mask of cap_texture OR-ed with the mask of cap_inventory.
 
+// The timing of a single finished request, as reported by libcurl.
+struct AICurlTimings {
+  enum phase_type {
+	dns,					// Name lookup.
+	connect,				// TCP connect.
+	tls,					// SSL handshake.
+	wait,					// Waiting for the first byte of the reply.
+	transfer,				// Receiving the reply.
+	number_of_phases
+  };
+  U32 phase[number_of_phases];	// Time spent in each phase, in milliseconds. Zero for phases that were skipped.
+  F32 time_to_first_byte;		// Time from the start of the request till the first byte was received, in seconds.
+  bool reused_connection;		// True if no new connection had to be made.
+  bool valid;					// False if no timing information is available (nothing was received).
+
+  AICurlTimings(void) : time_to_first_byte(0.f), reused_connection(false), valid(false) { }
+};
+
 //-----------------------------------------------------------------------------
 // AIPerService
 
@@ -155,12 +175,20 @@ class AIPerService {
 	  U32 mDownloading;							// The number of active easy handles with this service for which data was received.
 	  U16 mMaxPipelinedRequests;				// The maximum number of accepted requests for this service and (approved) capability type, that didn't finish yet.
 	  U16 mConcurrentConnections;				// The maximum number of allowed concurrent connections to the service of this capability type.
+	  U16 mAdaptiveConnections;					// AIMD ceiling on mAdded, halved upon congestion and incremented after a full window without. See connection_limit().
+	  U16 mAdaptiveWindow;						// The number of requests that finished since the current window started.
+	  bool mWindowCongested;					// Set when any request of the current window was congested.
+	  F32 mBaseLatency;							// Slowly rising minimum of the observed time to first byte, in seconds (0 if not known yet).
 
 	  // Declare, not define, constructor and destructor - in order to avoid instantiation of queued_request_type from header.
 	  CapabilityType(void);
 	  ~CapabilityType();
 
 	  S32 pipelined_requests(void) const { return mApprovedRequests + mQueuedCommands + mQueuedRequests.size() + mAdded; }
+	  // The number of connections that may currently be used by this CT.
+	  U16 connection_limit(void) const { return llmin(mAdaptiveConnections, mConcurrentConnections); }
+	  // Feed the result of a finished request into the AIMD controller.
+	  void adapt_concurrency(bool congested, F32 time_to_first_byte);
 	};
 
 	friend class AIServiceBar;
@@ -173,11 +201,25 @@ class AIPerService {
 	int mEventPolls;							// Number of active event poll handles with this service.
 	int mEstablishedConnections;				// Number of connected sockets to this service.
 
+	// Timing statistics, updated by the curl thread whenever a request finishes.
+	AIHistogram mPhaseTimes[AICurlTimings::number_of_phases];	// The time in ms spent in each phase of a request.
+	AIHistogram mInFlight;						// The number of active easy handles with this service, at the moment one of them finished.
+	U32 mNewConnections;						// The number of finished requests that had to make a new connection.
+	U32 mReusedConnections;						// The number of finished requests that reused an existing connection.
+
+	// The same, for the HTTP console: only since the console was last opened.
+	AIHistogram mConsoleWaitTimes;				// The time in ms between sending a request and receiving the first byte of the reply.
+	AIHistogram mConsoleTransferTimes;			// The time in ms spent receiving the reply.
+	U32 mConsoleNewConnections;
+	U32 mConsoleReusedConnections;
+
 	U32 mUsedCT;								// Bit mask with one bit per capability type. A '1' means the capability was in use since the last resetUsedCT().
 	U32 mCTInUse;								// Bit mask with one bit per capability type. A '1' means the capability is in use right now.
 
 	// Helper struct, used in the static resetUsed.
 	struct ResetUsed { void operator()(instance_map_type::value_type const& service) const; };
+	// Helper struct, used in the static resetAllConsoleStats.
+	struct ResetConsoleStats { void operator()(instance_map_type::value_type const& service) const; };
 
 	void redivide_connections(void);
 	void mark_inuse(AICapabilityType capability_type)
@@ -272,7 +314,8 @@ class AIPerService {
 	void removed_from_command_queue(AICapabilityType capability_type) { --mCapabilityType[capability_type].mQueuedCommands; }
 	void added_to_multi_handle(AICapabilityType capability_type, bool event_poll);		// Called when an easy handle for this service has been added to the multi handle.
 	void removed_from_multi_handle(AICapabilityType capability_type, bool event_poll,
-								   bool downloaded_something, bool success);			// Called when an easy handle for this service is removed again from the multi handle.
+								   bool downloaded_something, bool success,
+								   bool congested, AICurlTimings const& timings);		// Called when an easy handle for this service is removed again from the multi handle.
 	void download_started(AICapabilityType capability_type) { ++mCapabilityType[capability_type].mDownloading; }
 	bool throttled(AICapabilityType capability_type) const;		// Returns true if the maximum number of allowed requests for this service/capability type have been added to the multi handle.
 	bool nothing_added(AICapabilityType capability_type) const { return mCapabilityType[capability_type].mAdded == 0; }
@@ -297,6 +340,15 @@ class AIPerService {
 	// Called when CurlConcurrentConnectionsPerService changes.
 	static void adjust_concurrent_connections(int increment);
 
+	// Return the timing statistics of this service as LLSD.
+	LLSD getTimingStats(void) const;
+	// Return the timing statistics of all services, as a map with the service names as keys.
+	static LLSD getAllTimingStats(void);
+	// Restart the statistics that the HTTP console shows. The statistics above are not affected.
+	void resetConsoleStats(void);
+	// Idem, for all services. Called when the HTTP console is opened.
+	static void resetAllConsoleStats(void) { copy_forEach(ResetConsoleStats()); }
+
 	// A helper class to decrement mApprovedRequests after requests approved by approveHTTPRequestFor were handled.
 	class Approvement : public LLThreadSafeRefCount {
 	  private:
@@ -305,6 +305,9 @@ class CurlEasyRequest : public CurlEasyHandle {
 	// If result != CURLE_FAILED_INIT then also info was filled.
 	void getResult(CURLcode* result, AITransferInfo* info = NULL);
 
+	// Called by MultiHandle::remove_easy_request() to fill timings with the curl timing phases of a finished transfer.
+	void getTimings(AICurlTimings& timings) const;
+
 	// For debugging purposes.
 	void print_curl_timings(void) const;
 
@@ -464,6 +467,9 @@ class BufferedCurlEasyRequest : public CurlEasyRequest {
 	// Returns true if the request was a success.
 	bool success(void) const { return mResult == CURLE_OK && mStatus >= 200 && mStatus < 400; }
 
+	// Returns true if the request failed in a way that suggests the service is overloaded.
+	bool congested(void) const { return mResult == CURLE_OPERATION_TIMEDOUT || mStatus == HTTP_SERVICE_UNAVAILABLE || mStatus == HTTP_BAD_GATEWAY; }
+
 	// Return true when prepRequest was already called and the object has not been
 	// invalidated as a result of calling aborted().
 	bool isValid(void) const { return !!mResponder; }
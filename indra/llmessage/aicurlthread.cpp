@@ -203,6 +203,17 @@ int ioctlsocket(int fd, int, unsigned long* nonblocking_enable)
 
 #define WINDOWS_CODE (LL_WINDOWS || DEBUG_WINDOWS_CODE_ON_LINUX)
 
+// On linux, use epoll instead of select(): the kernel keeps track of the filedescriptors
+// that we're interested in, so we only need to pass on changes as libcurl reports them,
+// instead of rebuilding two fd_set's every time we go to sleep. It also lifts the
+// FD_SETSIZE limit on the number of concurrent connections.
+#if LL_LINUX && !DEBUG_WINDOWS_CODE_ON_LINUX
+#define USE_EPOLL 1
+#include <sys/epoll.h>
+#else
+#define USE_EPOLL 0
+#endif
+
 #undef AICurlPrivate
 
 namespace AICurlPrivate {
@@ -727,6 +738,93 @@ bool MergeIterator::next(curl_socket_t& fd_out, int& ev_bitmask_out)
   return true;
 }
 
+#if USE_EPOLL
+//-----------------------------------------------------------------------------
+// EpollSet
+//
+// This class wraps an epoll filedescriptor that contains all sockets of libcurl
+// (and the wake up filedescriptor of the curl thread). It is used instead of the
+// two PollSet's, if available.
+
+class EpollSet
+{
+  public:
+	EpollSet(void);
+	~EpollSet();
+
+	// Return false if epoll_create1() failed, in which case we fall back to select().
+	bool is_valid(void) const { return mEpollFd != -1; }
+
+	// Change the events that we're interested in for fd from old_action to action (CURL_POLL_NONE, CURL_POLL_IN, CURL_POLL_OUT or CURL_POLL_INOUT).
+	void update(curl_socket_t fd, int old_action, int action);
+
+	// Wait at most timeout_ms milliseconds for events. Returns the number of events, or -1 on error (see errno).
+	int wait(long timeout_ms);
+
+	// Return the filedescriptor and corresponding CURL_CSELECT_* bitmask of event i (0 <= i < value returned by wait()).
+	curl_socket_t fd(int i) const { return mEvents[i].data.fd; }
+	int ev_bitmask(int i) const;
+
+  private:
+	int mEpollFd;
+	std::vector<struct epoll_event> mEvents;	// Output variable of epoll_wait().
+};
+
+// The maximum number of events returned by a single call to epoll_wait().
+// Any remaining events are returned by the next call, because we use level triggered mode.
+static size_t const max_epoll_events = 256;
+
+EpollSet::EpollSet(void) : mEpollFd(epoll_create1(EPOLL_CLOEXEC)), mEvents(max_epoll_events)
+{
+  if (mEpollFd == -1)
+  {
+	llwarns << "epoll_create1() failed: " << errno << ", " << strerror(errno) << ". Falling back to using select()." << llendl;
+  }
+}
+
+EpollSet::~EpollSet()
+{
+  if (mEpollFd != -1)
+  {
+	close(mEpollFd);
+  }
+}
+
+void EpollSet::update(curl_socket_t fd, int old_action, int action)
+{
+  int op = (action == CURL_POLL_NONE) ? EPOLL_CTL_DEL : (old_action == CURL_POLL_NONE) ? EPOLL_CTL_ADD : EPOLL_CTL_MOD;
+  struct epoll_event event;
+  event.events = ((action & CURL_POLL_IN) ? EPOLLIN : 0) | ((action & CURL_POLL_OUT) ? EPOLLOUT : 0);
+  event.data.u64 = 0;
+  event.data.fd = fd;
+  if (epoll_ctl(mEpollFd, op, fd, &event) == -1)
+  {
+	// A filedescriptor that was closed behind our back was already removed from the set.
+	if (op != EPOLL_CTL_DEL || (errno != EBADF && errno != ENOENT))
+	{
+	  llwarns << "epoll_ctl(" << op << ", " << fd << ") failed: " << errno << ", " << strerror(errno) << llendl;
+	}
+  }
+}
+
+int EpollSet::wait(long timeout_ms)
+{
+  return epoll_wait(mEpollFd, &mEvents[0], mEvents.size(), timeout_ms);
+}
+
+int EpollSet::ev_bitmask(int i) const
+{
+  U32 const events = mEvents[i].events;
+  int ev_bitmask = 0;
+  // Just like select(), report errors and hang ups as readable (and errors as writable), so that libcurl finds out about them.
+  if ((events & (EPOLLIN | EPOLLHUP | EPOLLERR)))
+	ev_bitmask |= CURL_CSELECT_IN;
+  if ((events & (EPOLLOUT | EPOLLERR)))
+	ev_bitmask |= CURL_CSELECT_OUT;
+  return ev_bitmask;
+}
+#endif // USE_EPOLL
+
 //-----------------------------------------------------------------------------
 // CurlSocketInfo
 
@@ -804,8 +902,17 @@ void CurlSocketInfo::set_action(int action)
 
   Dout(dc::curl, "CurlSocketInfo::set_action(" << action_str(mAction) << " --> " << action_str(action) << ") [" << (void*)mEasyRequest.get_ptr().get() << "]");
   int toggle_action = mAction ^ action; 
+#if USE_EPOLL
+  if (mMultiHandle.mEpollSet && toggle_action)
+  {
+	mMultiHandle.mEpollSet->update(mSocketFd, mAction, action);
+  }
+  bool const use_poll_sets = !mMultiHandle.mEpollSet;
+#else
+  bool const use_poll_sets = true;
+#endif
   mAction = action;
-  if ((toggle_action & CURL_POLL_IN))
+  if ((toggle_action & CURL_POLL_IN) && use_poll_sets)
   {
 	if ((action & CURL_POLL_IN))
 	  mMultiHandle.mReadPollSet->add(this);
@@ -816,7 +923,8 @@ void CurlSocketInfo::set_action(int action)
   {
 	if ((action & CURL_POLL_OUT))
 	{
-	  mMultiHandle.mWritePollSet->add(this);
+	  if (use_poll_sets)
+		mMultiHandle.mWritePollSet->add(this);
 	  if (mTimeout)
 	  {
 		  // Note that this detection normally doesn't work because mTimeout will be zero.
@@ -826,7 +934,8 @@ void CurlSocketInfo::set_action(int action)
 	}
 	else
 	{
-	  mMultiHandle.mWritePollSet->remove(this);
+	  if (use_poll_sets)
+		mMultiHandle.mWritePollSet->remove(this);
 
 	  // The following is a bit of a hack, needed because of the lack of proper timeout callbacks in libcurl.
 	  // The removal of CURL_POLL_OUT could be part of the SSL handshake, therefore check if we're already connected:
@@ -1388,6 +1497,12 @@ void AICurlThread::run(void)
 
   {
 	AICurlMultiHandle_wat multi_handle_w(AICurlMultiHandle::getInstance());
+#if USE_EPOLL
+	if (multi_handle_w->mEpollSet && mWakeUpFd != CURL_SOCKET_BAD)
+	{
+	  multi_handle_w->mEpollSet->update(mWakeUpFd, CURL_POLL_NONE, CURL_POLL_IN);
+	}
+#endif
 	while(mRunning)
 	{
 	  // If mRunning is true then we can only get here if mWakeUpFd != CURL_SOCKET_BAD.
@@ -1412,31 +1527,10 @@ void AICurlThread::run(void)
 	  }
 
 	  // If we get here then mWakeUpFlag has been false since we grabbed the lock.
-	  // We're now entering select(), during which the main thread will write to the pipe/socket
+	  // We're now entering select() or epoll_wait(), during which the main thread will write to the pipe/socket
 	  // to wake us up, because it can't get the lock.
 
-	  // Copy the next batch of file descriptors from the PollSets mFileDescriptors into their mFdSet.
-	  multi_handle_w->mReadPollSet->refresh();
-	  refresh_t wres = multi_handle_w->mWritePollSet->refresh();
-	  // Add wake up fd if any, and pass NULL to select() if a set is empty.
-	  fd_set* read_fd_set = multi_handle_w->mReadPollSet->access();
-	  FD_SET(mWakeUpFd, read_fd_set);
-	  fd_set* write_fd_set = ((wres & empty)) ? NULL : multi_handle_w->mWritePollSet->access();
-	  // Calculate nfds (ignored on windows).
-#if !WINDOWS_CODE
-	  curl_socket_t const max_rfd = llmax(multi_handle_w->mReadPollSet->get_max_fd(), mWakeUpFd);
-	  curl_socket_t const max_wfd = multi_handle_w->mWritePollSet->get_max_fd();
-	  int nfds = llmax(max_rfd, max_wfd) + 1;
-	  llassert(1 <= nfds && nfds <= FD_SETSIZE);
-	  llassert((max_rfd == -1) == (read_fd_set == NULL) &&
-			   (max_wfd == -1) == (write_fd_set == NULL));	// Needed on Windows.
-	  llassert((max_rfd == -1 || multi_handle_w->mReadPollSet->is_set(max_rfd)) &&
-			   (max_wfd == -1 || multi_handle_w->mWritePollSet->is_set(max_wfd)));
-#else
-	  int nfds = 64;
-#endif
 	  int ready = 0;
-	  struct timeval timeout;
 	  // Update AICurlTimer::sTime_1ms.
 	  AICurlTimer::sTime_1ms = get_clock_count() * AICurlTimer::sClockWidth_1ms;
 	  Dout(dc::curl, "AICurlTimer::sTime_1ms = " << AICurlTimer::sTime_1ms);
@@ -1473,104 +1567,146 @@ void AICurlThread::run(void)
 		  llinfos << "Timeout of select() call by curl thread reset (to " << timeout_ms << " ms)." << llendl;
 		mZeroTimeout = 0;
 	  }
-	  timeout.tv_sec = timeout_ms / 1000;
-	  timeout.tv_usec = (timeout_ms % 1000) * 1000;
-#ifdef CWDEBUG
-#ifdef DEBUG_CURLIO
-	  Dout(dc::curl|flush_cf|continued_cf, "select(" << nfds << ", " << DebugFdSet(nfds, read_fd_set) << ", " << DebugFdSet(nfds, write_fd_set) << ", NULL, timeout = " << timeout_ms << " ms) = ");
-#else
-	  static int last_nfds = -1;
-	  static long last_timeout_ms = -1;
-	  static int same_count = 0;
-	  bool same = (nfds == last_nfds && timeout_ms == last_timeout_ms);
-	  if (!same)
+#if USE_EPOLL
+	  if (multi_handle_w->mEpollSet)
 	  {
-		if (same_count > 1)
-		  Dout(dc::curl, "Last select() call repeated " << same_count << " times.");
-		Dout(dc::curl|flush_cf|continued_cf, "select(" << nfds << ", ..., timeout = " << timeout_ms << " ms) = ");
-		same_count = 1;
+		// The epoll set is kept up to date by CurlSocketInfo::set_action, so there is nothing to refresh.
+		ready = multi_handle_w->mEpollSet->wait(timeout_ms);
+		mWakeUpFlagMutex.unlock();
+		if (ready == -1)
+		{
+		  // Unlike select(), epoll_wait() doesn't fail when one of the filedescriptors was closed behind our back;
+		  // such a filedescriptor is simply removed from the set and the transaction will time out.
+		  if (errno != EINTR)
+		  {
+			llwarns << "epoll_wait() failed: " << errno << ", " << strerror(errno) << llendl;
+		  }
+		  continue;
+		}
 	  }
 	  else
-	  {
-		++same_count;
-	  }
 #endif
+	  {
+		// Copy the next batch of file descriptors from the PollSets mFileDescriptors into their mFdSet.
+		multi_handle_w->mReadPollSet->refresh();
+		refresh_t wres = multi_handle_w->mWritePollSet->refresh();
+		// Add wake up fd if any, and pass NULL to select() if a set is empty.
+		fd_set* read_fd_set = multi_handle_w->mReadPollSet->access();
+		FD_SET(mWakeUpFd, read_fd_set);
+		fd_set* write_fd_set = ((wres & empty)) ? NULL : multi_handle_w->mWritePollSet->access();
+		// Calculate nfds (ignored on windows).
+#if !WINDOWS_CODE
+		curl_socket_t const max_rfd = llmax(multi_handle_w->mReadPollSet->get_max_fd(), mWakeUpFd);
+		curl_socket_t const max_wfd = multi_handle_w->mWritePollSet->get_max_fd();
+		int nfds = llmax(max_rfd, max_wfd) + 1;
+		llassert(1 <= nfds && nfds <= FD_SETSIZE);
+		llassert((max_rfd == -1) == (read_fd_set == NULL) &&
+				 (max_wfd == -1) == (write_fd_set == NULL));	// Needed on Windows.
+		llassert((max_rfd == -1 || multi_handle_w->mReadPollSet->is_set(max_rfd)) &&
+				 (max_wfd == -1 || multi_handle_w->mWritePollSet->is_set(max_wfd)));
+#else
+		int nfds = 64;
 #endif
-	  ready = select(nfds, read_fd_set, write_fd_set, NULL, &timeout);
-	  mWakeUpFlagMutex.unlock();
+		struct timeval timeout;
+		timeout.tv_sec = timeout_ms / 1000;
+		timeout.tv_usec = (timeout_ms % 1000) * 1000;
 #ifdef CWDEBUG
 #ifdef DEBUG_CURLIO
-	  Dout(dc::finish|cond_error_cf(ready == -1), ready);
+		Dout(dc::curl|flush_cf|continued_cf, "select(" << nfds << ", " << DebugFdSet(nfds, read_fd_set) << ", " << DebugFdSet(nfds, write_fd_set) << ", NULL, timeout = " << timeout_ms << " ms) = ");
 #else
-	  static int last_ready = -2;
-	  static int last_errno = 0;
-	  if (!same)
+		static int last_nfds = -1;
+		static long last_timeout_ms = -1;
+		static int same_count = 0;
+		bool same = (nfds == last_nfds && timeout_ms == last_timeout_ms);
+		if (!same)
+		{
+		  if (same_count > 1)
+			Dout(dc::curl, "Last select() call repeated " << same_count << " times.");
+		  Dout(dc::curl|flush_cf|continued_cf, "select(" << nfds << ", ..., timeout = " << timeout_ms << " ms) = ");
+		  same_count = 1;
+		}
+		else
+		{
+		  ++same_count;
+		}
+#endif
+#endif
+		ready = select(nfds, read_fd_set, write_fd_set, NULL, &timeout);
+		mWakeUpFlagMutex.unlock();
+#ifdef CWDEBUG
+#ifdef DEBUG_CURLIO
 		Dout(dc::finish|cond_error_cf(ready == -1), ready);
-	  else if (ready != last_ready || (ready == -1 && errno != last_errno))
-	  {
-		if (same_count > 1)
-		  Dout(dc::curl, "Last select() call repeated " << same_count << " times.");
-		Dout(dc::curl|cond_error_cf(ready == -1), "select(" << last_nfds << ", ..., timeout = " << last_timeout_ms << " ms) = " << ready);
-		same_count = 1;
-	  }
-	  last_nfds = nfds;
-	  last_timeout_ms = timeout_ms;
-	  last_ready = ready;
-	  if (ready == -1)
-		last_errno = errno;
+#else
+		static int last_ready = -2;
+		static int last_errno = 0;
+		if (!same)
+		  Dout(dc::finish|cond_error_cf(ready == -1), ready);
+		else if (ready != last_ready || (ready == -1 && errno != last_errno))
+		{
+		  if (same_count > 1)
+			Dout(dc::curl, "Last select() call repeated " << same_count << " times.");
+		  Dout(dc::curl|cond_error_cf(ready == -1), "select(" << last_nfds << ", ..., timeout = " << last_timeout_ms << " ms) = " << ready);
+		  same_count = 1;
+		}
+		last_nfds = nfds;
+		last_timeout_ms = timeout_ms;
+		last_ready = ready;
+		if (ready == -1)
+		  last_errno = errno;
 #endif
 #endif
-	  // Select returns the total number of bits set in each of the fd_set's (upon return),
-	  // or -1 when an error occurred. A value of 0 means that a timeout occurred.
-	  if (ready == -1)
-	  {
-		llwarns << "select() failed: " << errno << ", " << strerror(errno) << llendl;
-		if (errno == EBADF)
+		// Select returns the total number of bits set in each of the fd_set's (upon return),
+		// or -1 when an error occurred. A value of 0 means that a timeout occurred.
+		if (ready == -1)
 		{
-		  // Somewhere (fmodex?) one of our file descriptors was closed. Try to recover by finding out which.
-		  llassert_always(!is_bad(mWakeUpFd, false));		// We can't recover from this.
-		  PollSet* found = NULL;
-		  // Run over all read file descriptors.
-		  multi_handle_w->mReadPollSet->refresh();
-		  multi_handle_w->mReadPollSet->reset();
-		  curl_socket_t fd;
-		  while ((fd = multi_handle_w->mReadPollSet->get()) != CURL_SOCKET_BAD)
+		  llwarns << "select() failed: " << errno << ", " << strerror(errno) << llendl;
+		  if (errno == EBADF)
 		  {
-			if (is_bad(fd, false))
+			// Somewhere (fmodex?) one of our file descriptors was closed. Try to recover by finding out which.
+			llassert_always(!is_bad(mWakeUpFd, false));		// We can't recover from this.
+			PollSet* found = NULL;
+			// Run over all read file descriptors.
+			multi_handle_w->mReadPollSet->refresh();
+			multi_handle_w->mReadPollSet->reset();
+			curl_socket_t fd;
+			while ((fd = multi_handle_w->mReadPollSet->get()) != CURL_SOCKET_BAD)
 			{
-			  found = multi_handle_w->mReadPollSet;
-			  break;
+			  if (is_bad(fd, false))
+			  {
+				found = multi_handle_w->mReadPollSet;
+				break;
+			  }
+			  multi_handle_w->mReadPollSet->next();
 			}
-			multi_handle_w->mReadPollSet->next();
-		  }
-		  if (!found)
-		  {
-			// Try all write file descriptors.
-			refresh_t wres = multi_handle_w->mWritePollSet->refresh();
-			if (!(wres & empty))
+			if (!found)
 			{
-			  multi_handle_w->mWritePollSet->reset();
-			  while ((fd = multi_handle_w->mWritePollSet->get()) != CURL_SOCKET_BAD)
+			  // Try all write file descriptors.
+			  refresh_t wres = multi_handle_w->mWritePollSet->refresh();
+			  if (!(wres & empty))
 			  {
-				if (is_bad(fd, true))
+				multi_handle_w->mWritePollSet->reset();
+				while ((fd = multi_handle_w->mWritePollSet->get()) != CURL_SOCKET_BAD)
 				{
-				  found = multi_handle_w->mWritePollSet;
-				  break;
+				  if (is_bad(fd, true))
+				  {
+					found = multi_handle_w->mWritePollSet;
+					break;
+				  }
+				  multi_handle_w->mWritePollSet->next();
 				}
-				multi_handle_w->mWritePollSet->next();
 			  }
 			}
+			llassert_always(found);	// It makes no sense to continue if we can't recover.
+			// Find the corresponding CurlSocketInfo
+			CurlSocketInfo* sp = found->contains(fd);
+			llassert_always(sp);		// fd was just *read* from this sp.
+			sp->mark_dead();													// Make sure it's never used again.
+			AICurlEasyRequest_wat curl_easy_request_w(*sp->getEasyRequest());
+			curl_easy_request_w->pause(CURLPAUSE_ALL);						// Keep libcurl at bay.
+			curl_easy_request_w->bad_file_descriptor(curl_easy_request_w);	// Make the main thread cleanly terminate this transaction.
 		  }
-		  llassert_always(found);	// It makes no sense to continue if we can't recover.
-		  // Find the corresponding CurlSocketInfo
-		  CurlSocketInfo* sp = found->contains(fd);
-		  llassert_always(sp);		// fd was just *read* from this sp.
-		  sp->mark_dead();													// Make sure it's never used again.
-		  AICurlEasyRequest_wat curl_easy_request_w(*sp->getEasyRequest());
-		  curl_easy_request_w->pause(CURLPAUSE_ALL);						// Keep libcurl at bay.
-		  curl_easy_request_w->bad_file_descriptor(curl_easy_request_w);	// Make the main thread cleanly terminate this transaction.
+		  continue;
 		}
-		continue;
 	  }
 	  // Update the clocks.
 	  AICurlTimer::sTime_1ms = get_clock_count() * AICurlTimer::sClockWidth_1ms;
@@ -1598,26 +1734,54 @@ void AICurlThread::run(void)
 	  }
 	  else
 	  {
-		if (multi_handle_w->mReadPollSet->is_set(mWakeUpFd))
+#if USE_EPOLL
+		if (multi_handle_w->mEpollSet)
 		{
-		  // Process commands from main-thread. This can add or remove filedescriptors from the poll sets.
-		  wakeup(multi_handle_w);
-		  --ready;
+		  EpollSet* epoll_set = multi_handle_w->mEpollSet;
+		  // Process commands from main-thread first, just like below.
+		  for (int i = 0; i < ready; ++i)
+		  {
+			if (epoll_set->fd(i) == mWakeUpFd)
+			{
+			  wakeup(multi_handle_w);
+			  break;
+			}
+		  }
+		  // Handle all active filedescriptors. If libcurl closed one of them in the meantime (or even reused the
+		  // same number for a new connection) then socket_action() just returns without doing anything harmful.
+		  for (int i = 0; i < ready; ++i)
+		  {
+			curl_socket_t fd = epoll_set->fd(i);
+			if (fd != mWakeUpFd)
+			{
+			  multi_handle_w->socket_action(fd, epoll_set->ev_bitmask(i));
+			}
+		  }
 		}
-		// Handle all active filedescriptors.
-		MergeIterator iter(multi_handle_w->mReadPollSet, multi_handle_w->mWritePollSet);
-		curl_socket_t fd;
-		int ev_bitmask;
-		while (ready > 0 && iter.next(fd, ev_bitmask))
+		else
+#endif
 		{
-		  ready -= (ev_bitmask == (CURL_CSELECT_IN|CURL_CSELECT_OUT)) ? 2 : 1;
-		  // This can cause libcurl to do callbacks and remove filedescriptors, causing us to reset their bits in the poll sets.
-		  multi_handle_w->socket_action(fd, ev_bitmask);
-		  llassert(ready >= 0);
+		  if (multi_handle_w->mReadPollSet->is_set(mWakeUpFd))
+		  {
+			// Process commands from main-thread. This can add or remove filedescriptors from the poll sets.
+			wakeup(multi_handle_w);
+			--ready;
+		  }
+		  // Handle all active filedescriptors.
+		  MergeIterator iter(multi_handle_w->mReadPollSet, multi_handle_w->mWritePollSet);
+		  curl_socket_t fd;
+		  int ev_bitmask;
+		  while (ready > 0 && iter.next(fd, ev_bitmask))
+		  {
+			ready -= (ev_bitmask == (CURL_CSELECT_IN|CURL_CSELECT_OUT)) ? 2 : 1;
+			// This can cause libcurl to do callbacks and remove filedescriptors, causing us to reset their bits in the poll sets.
+			multi_handle_w->socket_action(fd, ev_bitmask);
+			llassert(ready >= 0);
+		  }
+		  // Note that ready is not necessarily 0 here, because it's possible
+		  // that libcurl removed file descriptors which we subsequently
+		  // didn't handle.
 		}
-		// Note that ready is not necessarily 0 here, because it's possible
-		// that libcurl removed file descriptors which we subsequently
-		// didn't handle.
 	  }
 	  multi_handle_w->check_msg_queue();
 	}
@@ -1632,10 +1796,18 @@ void AICurlThread::run(void)
 
 LLAtomicU32 MultiHandle::sTotalAdded;
 
-MultiHandle::MultiHandle(void) : mTimeout(-1), mReadPollSet(NULL), mWritePollSet(NULL)
+MultiHandle::MultiHandle(void) : mTimeout(-1), mReadPollSet(NULL), mWritePollSet(NULL), mEpollSet(NULL)
 {
   mReadPollSet = new PollSet;
   mWritePollSet = new PollSet;
+#if USE_EPOLL
+  mEpollSet = new EpollSet;
+  if (!mEpollSet->is_valid())
+  {
+	delete mEpollSet;
+	mEpollSet = NULL;
+  }
+#endif
   check_multi_code(curl_multi_setopt(mMultiHandle, CURLMOPT_SOCKETFUNCTION, &MultiHandle::socket_callback));
   check_multi_code(curl_multi_setopt(mMultiHandle, CURLMOPT_SOCKETDATA, this));
   check_multi_code(curl_multi_setopt(mMultiHandle, CURLMOPT_TIMERFUNCTION, &MultiHandle::timer_callback));
@@ -1653,6 +1825,9 @@ MultiHandle::~MultiHandle()
 	finish_easy_request(*iter, CURLE_GOT_NOTHING);	// Error code is not used anyway.
 	remove_easy_request(*iter);
   }
+#if USE_EPOLL
+  delete mEpollSet;
+#endif
   delete mWritePollSet;
   delete mReadPollSet;
 }
@@ -1852,11 +2027,17 @@ CURLMcode MultiHandle::remove_easy_request(addedEasyRequests_type::iterator cons
 	AICurlEasyRequest_wat curl_easy_request_w(**iter);
 	bool downloaded_something = curl_easy_request_w->received_data();
 	bool success = curl_easy_request_w->success();
+	bool congested = curl_easy_request_w->congested();
+	AICurlTimings timings;
+	if (downloaded_something)
+	{
+	  curl_easy_request_w->getTimings(timings);
+	}
 	res = curl_easy_request_w->remove_handle_from_multi(curl_easy_request_w, mMultiHandle);
 	capability_type = curl_easy_request_w->capability_type();
 	event_poll = curl_easy_request_w->is_event_poll();
 	per_service = curl_easy_request_w->getPerServicePtr();
-	PerService_wat(*per_service)->removed_from_multi_handle(capability_type, event_poll, downloaded_something, success);		// (About to be) removed from mAddedEasyRequests.
+	PerService_wat(*per_service)->removed_from_multi_handle(capability_type, event_poll, downloaded_something, success, congested, timings);		// (About to be) removed from mAddedEasyRequests.
 #ifdef SHOW_ASSERT
 	curl_easy_request_w->mRemovedPerCommand = as_per_command;
 #endif
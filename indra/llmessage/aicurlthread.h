@@ -42,6 +42,7 @@ namespace curlthread {
 extern U32 curl_max_total_concurrent_connections;
 
 class PollSet;
+class EpollSet;
 
 // For ordering a std::set with AICurlEasyRequest objects.
 struct AICurlEasyRequestCompare {
@@ -114,6 +115,7 @@ class MultiHandle : public CurlMultiHandle
 
 	PollSet* mReadPollSet;
 	PollSet* mWritePollSet;
+	EpollSet* mEpollSet;		// If non-NULL, this is used instead of the poll sets (linux only).
 };
 
 } // namespace curlthread
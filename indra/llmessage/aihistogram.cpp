@@ -0,0 +1,91 @@
+/**
+ * @file aihistogram.cpp
+ * @brief Implementation of AIHistogram
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution.
+ */
+
+#include "sys.h"
+#include "aihistogram.h"
+#include "llsd.h"
+
+void AIHistogram::reset(void)
+{
+  for (int i = 0; i < number_of_buckets; ++i)
+  {
+	mBuckets[i] = 0;
+  }
+  mCount = 0;
+  mSum = 0;
+  mMax = 0;
+}
+
+void AIHistogram::add(U32 value)
+{
+  int bucket = 0;
+  for (U32 v = value; v && bucket < number_of_buckets - 1; v >>= 1)
+  {
+	++bucket;
+  }
+  ++mBuckets[bucket];
+  ++mCount;
+  mSum += value;
+  if (value > mMax)
+  {
+	mMax = value;
+  }
+}
+
+U32 AIHistogram::percentile(double fraction) const
+{
+  if (mCount == 0)
+  {
+	return 0;
+  }
+  U32 const wanted = (U32)(fraction * mCount + 0.5);
+  U32 seen = 0;
+  for (int bucket = 0; bucket < number_of_buckets - 1; ++bucket)
+  {
+	seen += mBuckets[bucket];
+	if (seen >= wanted)
+	{
+	  // The largest value that fits in this bucket, but never more than what we actually saw.
+	  U32 const upper = bucket ? ((U32)1 << bucket) - 1 : 0;
+	  return upper < mMax ? upper : mMax;
+	}
+  }
+  return mMax;
+}
+
+LLSD AIHistogram::asLLSD(void) const
+{
+  LLSD result;
+  result["count"] = (LLSD::Integer)mCount;
+  result["mean"] = mean();
+  result["p50"] = (LLSD::Integer)percentile(0.50);
+  result["p90"] = (LLSD::Integer)percentile(0.90);
+  result["p99"] = (LLSD::Integer)percentile(0.99);
+  result["max"] = (LLSD::Integer)mMax;
+  LLSD buckets = LLSD::emptyArray();
+  for (int i = 0; i < number_of_buckets; ++i)
+  {
+	buckets.append((LLSD::Integer)mBuckets[i]);
+  }
+  result["buckets"] = buckets;
+  return result;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file aihistogram.h
+ * @brief Definition of class AIHistogram
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution.
+ */
+
+#ifndef AIHISTOGRAM_H
+#define AIHISTOGRAM_H
+
+#include "stdtypes.h"	// U32, U64
+
+class LLSD;
+
+// A histogram with logarithmic (power of two) buckets.
+//
+// Bucket 0 counts the values 0, bucket i > 0 counts the values in the range [2^(i-1), 2^i),
+// and the last bucket counts everything that is larger. This class does no locking; it is
+// meant to be a member of an object that is already protected by a lock (ie, AIPerService).
+class AIHistogram {
+  public:
+	static int const number_of_buckets = 20;
+
+  private:
+	U32 mBuckets[number_of_buckets];
+	U32 mCount;						// The total number of values added.
+	U64 mSum;						// The sum of all values added.
+	U32 mMax;						// The largest value added.
+
+  public:
+	AIHistogram(void) { reset(); }
+
+	void reset(void);
+	void add(U32 value);
+
+	U32 count(void) const { return mCount; }
+	U32 max(void) const { return mMax; }
+	double mean(void) const { return mCount ? (double)mSum / mCount : 0.0; }
+
+	// Return an upper bound of the value below which the given fraction (0...1) of all values lie.
+	U32 percentile(double fraction) const;
+
+	// Return the content as an LLSD map with the keys count, mean, p50, p90, p99, max and buckets.
+	LLSD asLLSD(void) const;
+};
+
+#endif // AIHISTOGRAM_H
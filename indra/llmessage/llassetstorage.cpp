@@ -301,6 +301,7 @@ void LLAssetStorage::_init(LLMessageSystem *msg,
 	mXferManager = xfer;
 	mVFS = vfs;
 	mStaticVFS = static_vfs;
+	mCoalescedDownloads = 0;
 
 	setUpstream(upstream_host);
 	msg->setHandlerFuncFast(_PREHASH_AssetUploadComplete, processUploadComplete, (void **)this);
@@ -362,7 +363,7 @@ void LLAssetStorage::_cleanupRequests(BOOL all, S32 error)
 						<< LLAssetType::lookup(tmp->getType()) << llendl;
 
 				timed_out.push_front(tmp);
-				iter = requests->erase(curiter);
+				iter = (RT_DOWNLOAD == rt) ? removePendingDownload(curiter) : requests->erase(curiter);
 			}
 		}
 	}
@@ -511,12 +512,13 @@ void LLAssetStorage::getAssetData(const LLUUID uuid, LLAssetType::EType type, LL
 		BOOL duplicate = FALSE;
 		
 		// check to see if there's a pending download of this uuid already
-		for (request_list_t::iterator iter = mPendingDownloads.begin();
-			 iter != mPendingDownloads.end(); ++iter )
+		const download_bucket_t* pending = getPendingDownloads(uuid, type);
+		if (pending)
 		{
-			LLAssetRequest  *tmp = *iter;
-			if ((type == tmp->getType()) && (uuid == tmp->getUUID()))
+			for (download_bucket_t::const_iterator iter = pending->begin();
+				 iter != pending->end(); ++iter)
 			{
+				LLAssetRequest *tmp = **iter;
 				if (callback == tmp->mDownCallback && user_data == tmp->mUserData)
 				{
 					// this is a duplicate from the same subsystem - throw it away
@@ -524,14 +526,12 @@ void LLAssetStorage::getAssetData(const LLUUID uuid, LLAssetType::EType type, LL
 							<< "." << LLAssetType::lookup(type) << llendl;
 					return;
 				}
-				
-				// this is a duplicate request
-				// queue the request, but don't actually ask for it again
-				duplicate = TRUE;
 			}
-		}
-		if (duplicate)
-		{
+
+			// this is a duplicate request
+			// queue the request, but don't actually ask for it again
+			duplicate = TRUE;
+			++mCoalescedDownloads;
 			LL_DEBUGS("AssetStorage") << "Adding additional non-duplicate request for asset " << uuid 
 					<< "." << LLAssetType::lookup(type) << llendl;
 		}
@@ -559,7 +559,7 @@ void LLAssetStorage::_queueDataRequest(const LLUUID& uuid, LLAssetType::EType at
 		req->mUserData = user_data;
 		req->mIsPriority = is_priority;
 	
-		mPendingDownloads.push_back(req);
+		addPendingDownload(req);
 	
 		if (!duplicate)
 		{
@@ -613,17 +613,15 @@ void LLAssetStorage::downloadCompleteCallback(
 		return;
 	}
 
-	// Inefficient since we're doing a find through a list that may have thousands of elements.
-	// This is due for refactoring; we will probably change mPendingDownloads into a set.
-	request_list_t::iterator download_iter = std::find(gAssetStorage->mPendingDownloads.begin(), 
-													   gAssetStorage->mPendingDownloads.end(),
-													   req);
 	// If the LLAssetRequest doesn't exist in the downloads queue, then it either has already been deleted
 	// by _cleanupRequests, or it's a transfer.
-	if (download_iter != gAssetStorage->mPendingDownloads.end())
+	if ((req->getUUID() != file_id || req->getType() != file_type) &&
+		gAssetStorage->removePendingDownload(req))
 	{
+		// Re-file it under the asset that was actually delivered.
 		req->setUUID(file_id);
 		req->setType(file_type);
+		gAssetStorage->addPendingDownload(req);
 	}
 
 	if (LL_ERR_NOERR == result)
@@ -643,16 +641,16 @@ void LLAssetStorage::downloadCompleteCallback(
 	// SJB: We process the callbacks in reverse order, I do not know if this is important,
 	//      but I didn't want to mess with it.
 	request_list_t requests;
-	for (request_list_t::iterator iter = gAssetStorage->mPendingDownloads.begin();
-		 iter != gAssetStorage->mPendingDownloads.end();  )
+	download_index_t::iterator found = gAssetStorage->mPendingDownloadIndex.find(download_key_t(file_id, file_type));
+	if (found != gAssetStorage->mPendingDownloadIndex.end())
 	{
-		request_list_t::iterator curiter = iter++;
-		LLAssetRequest* tmp = *curiter;
-		if ((tmp->getUUID() == file_id) && (tmp->getType()== file_type))
+		for (download_bucket_t::iterator iter = found->second.begin();
+			 iter != found->second.end(); ++iter)
 		{
-			requests.push_front(tmp);
-			iter = gAssetStorage->mPendingDownloads.erase(curiter);
+			requests.push_front(**iter);
+			gAssetStorage->mPendingDownloads.erase(*iter);
 		}
+		gAssetStorage->mPendingDownloadIndex.erase(found);
 	}
 	for (request_list_t::iterator iter = requests.begin();
 		 iter != requests.end();  )
@@ -1088,6 +1086,63 @@ S32 LLAssetStorage::getNumPending(LLAssetStorage::ERequestType rt) const
 	return num_pending;
 }
 
+void LLAssetStorage::addPendingDownload(LLAssetRequest* req)
+{
+	request_list_t::iterator iter = mPendingDownloads.insert(mPendingDownloads.end(), req);
+	mPendingDownloadIndex[download_key_t(req->getUUID(), req->getType())].push_back(iter);
+}
+
+// Returns the iterator following iter in mPendingDownloads.
+LLAssetStorage::request_list_t::iterator LLAssetStorage::removePendingDownload(request_list_t::iterator iter)
+{
+	LLAssetRequest* req = *iter;
+	download_index_t::iterator found = mPendingDownloadIndex.find(download_key_t(req->getUUID(), req->getType()));
+	if (found != mPendingDownloadIndex.end())
+	{
+		download_bucket_t& bucket = found->second;
+		download_bucket_t::iterator entry = std::find(bucket.begin(), bucket.end(), iter);
+		if (entry != bucket.end())
+		{
+			bucket.erase(entry);
+		}
+		if (bucket.empty())
+		{
+			mPendingDownloadIndex.erase(found);
+		}
+	}
+	return mPendingDownloads.erase(iter);
+}
+
+bool LLAssetStorage::removePendingDownload(LLAssetRequest* req)
+{
+	download_index_t::iterator found = mPendingDownloadIndex.find(download_key_t(req->getUUID(), req->getType()));
+	if (found == mPendingDownloadIndex.end())
+	{
+		return false;
+	}
+	download_bucket_t& bucket = found->second;
+	for (download_bucket_t::iterator entry = bucket.begin(); entry != bucket.end(); ++entry)
+	{
+		if (**entry == req)
+		{
+			mPendingDownloads.erase(*entry);
+			bucket.erase(entry);
+			if (bucket.empty())
+			{
+				mPendingDownloadIndex.erase(found);
+			}
+			return true;
+		}
+	}
+	return false;
+}
+
+const LLAssetStorage::download_bucket_t* LLAssetStorage::getPendingDownloads(const LLUUID& uuid, LLAssetType::EType type) const
+{
+	download_index_t::const_iterator found = mPendingDownloadIndex.find(download_key_t(uuid, type));
+	return found == mPendingDownloadIndex.end() ? NULL : &found->second;
+}
+
 S32 LLAssetStorage::getNumPendingDownloads() const
 {
 	return getNumPending(RT_DOWNLOAD);
@@ -1240,7 +1295,14 @@ bool LLAssetStorage::deletePendingRequestImpl(LLAssetStorage::request_list_t* re
 	if (req)
 	{
 		// Remove the request from this list.
-		requests->remove(req);
+		if (requests == &mPendingDownloads)
+		{
+			removePendingDownload(req);
+		}
+		else
+		{
+			requests->remove(req);
+		}
 		S32 error = LL_ERR_TCP_TIMEOUT;
 		// Run callbacks.
 		if (req->mUpCallback)
@@ -1308,19 +1370,21 @@ const char* LLAssetStorage::getErrorString(S32 status)
 void LLAssetStorage::getAssetData(const LLUUID uuid, LLAssetType::EType type, void (*callback)(const char*, const LLUUID&, void *, S32, LLExtStat), void *user_data, BOOL is_priority)
 {
 	// check for duplicates here, since we're about to fool the normal duplicate checker
-	for (request_list_t::iterator iter = mPendingDownloads.begin();
-		 iter != mPendingDownloads.end();  )
+	const download_bucket_t* pending = getPendingDownloads(uuid, type);
+	if (pending)
 	{
-		LLAssetRequest* tmp = *iter++;
-		if (type == tmp->getType() && 
-			uuid == tmp->getUUID() &&
-			legacyGetDataCallback == tmp->mDownCallback &&
-			callback == ((LLLegacyAssetRequest *)tmp->mUserData)->mDownCallback &&
-			user_data == ((LLLegacyAssetRequest *)tmp->mUserData)->mUserData)
+		for (download_bucket_t::const_iterator iter = pending->begin();
+			 iter != pending->end(); ++iter)
 		{
-			// this is a duplicate from the same subsystem - throw it away
-			LL_DEBUGS("AssetStorage") << "Discarding duplicate request for UUID " << uuid << llendl;
-			return;
+			LLAssetRequest* tmp = **iter;
+			if (legacyGetDataCallback == tmp->mDownCallback &&
+				callback == ((LLLegacyAssetRequest *)tmp->mUserData)->mDownCallback &&
+				user_data == ((LLLegacyAssetRequest *)tmp->mUserData)->mUserData)
+			{
+				// this is a duplicate from the same subsystem - throw it away
+				LL_DEBUGS("AssetStorage") << "Discarding duplicate request for UUID " << uuid << llendl;
+				return;
+			}
 		}
 	}
 	
@@ -29,8 +29,10 @@
 #define LL_LLASSETSTORAGE_H
 
 #include <string>
+#include <vector>
 
 #include "lluuid.h"
+#include "sguuidhash.h"
 #include "lltimer.h"
 #include "llnamevalue.h"
 #include "llhost.h"
@@ -236,6 +238,29 @@ protected:
 	request_list_t mPendingDownloads;
 	request_list_t mPendingUploads;
 	request_list_t mPendingLocalUploads;
+
+	// Index of mPendingDownloads by asset, in request order, so that duplicate
+	// detection and completion fan-out don't scan the whole list.
+	// Only ever modify mPendingDownloads through the helpers below.
+	typedef std::pair<LLUUID, LLAssetType::EType> download_key_t;
+	struct download_key_hash
+	{
+		size_t operator()(const download_key_t& key) const
+		{
+			return boost::hash<LLUUID>()(key.first) ^ (size_t)key.second;
+		}
+	};
+	typedef std::vector<request_list_t::iterator> download_bucket_t;
+	typedef boost::unordered_map<download_key_t, download_bucket_t, download_key_hash> download_index_t;
+	download_index_t mPendingDownloadIndex;
+
+	void addPendingDownload(LLAssetRequest* req);
+	request_list_t::iterator removePendingDownload(request_list_t::iterator iter);
+	bool removePendingDownload(LLAssetRequest* req);
+	const download_bucket_t* getPendingDownloads(const LLUUID& uuid, LLAssetType::EType type) const;
+
+	// Requests that were attached to an already running download.
+	U32 mCoalescedDownloads;
 	
 	// Map of toxic assets - these caused problems when recently rezzed, so avoid them
 	toxic_asset_map_t	mToxicAssetMap;		// Objects in this list are known to cause problems and are not loaded
@@ -344,6 +369,12 @@ public:
 	static std::string getRequestName(ERequestType rt);
 
 	S32 getNumPendingDownloads() const;
+	// Distinct assets being downloaded; every other pending download
+	// piggy-backs on one of these.
+	S32 getNumInFlightDownloads() const { return (S32)mPendingDownloadIndex.size(); }
+	// Requests that were attached to an already running download, since the last reset.
+	U32 getNumCoalescedDownloads() const { return mCoalescedDownloads; }
+	void resetNumCoalescedDownloads() { mCoalescedDownloads = 0; }
 	S32 getNumPendingUploads() const;
 	S32 getNumPendingLocalUploads();
 	S32 getNumPending(ERequestType rt) const;
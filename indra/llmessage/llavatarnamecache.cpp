@@ -34,6 +34,7 @@
 #include "llhttpclient.h"
 #include "llsd.h"
 #include "llsdserialize.h"
+#include "lluuidhashmap.h"
 
 #include <boost/tokenizer.hpp>
 
@@ -80,7 +81,7 @@ namespace LLAvatarNameCache
 	signal_map_t sSignalMap;
 
 	// The cache at last, i.e. avatar names we know about.
-	typedef std::map<LLUUID, LLAvatarName> cache_t;
+	typedef LLUUIDHashMap<LLAvatarName> cache_t;
 	cache_t sCache;
 
 	// Send bulk lookup requests a few times a second at most.
@@ -265,7 +266,7 @@ protected:
 // Provide some fallback for agents that return errors
 void LLAvatarNameCache::handleAgentError(const LLUUID& agent_id)
 {
-	std::map<LLUUID,LLAvatarName>::iterator existing = sCache.find(agent_id);
+	cache_t::iterator existing = sCache.find(agent_id);
 	if (existing == sCache.end())
     {
         // there is no existing cache entry, so make a temporary name from legacy
@@ -382,7 +383,7 @@ void LLAvatarNameCache::legacyNameCallback(const LLUUID& agent_id,
 	// Retrieve the name and set it to never (or almost never...) expire: when we are using the legacy
 	// protocol, we do not get an expiration date for each name and there's no reason to ask the 
 	// data again and again so we set the expiration time to the largest value admissible.
-	std::map<LLUUID,LLAvatarName>::iterator av_record = sCache.find(agent_id);
+	cache_t::iterator av_record = sCache.find(agent_id);
 	LLAvatarName& av_name = av_record->second;
 	av_name.setExpires(MAX_UNREFRESHED_TIME);
 }
@@ -563,7 +564,9 @@ void LLAvatarNameCache::eraseUnrefreshed()
     {
         sLastExpireCheck = now;
 
-        for (cache_t::iterator it = sCache.begin(); it != sCache.end();)
+        // sCache can't be erased from while iterating it, so collect the expired ids first.
+        std::vector<LLUUID> expired;
+        for (cache_t::iterator it = sCache.begin(); it != sCache.end(); ++it)
         {
             const LLAvatarName& av_name = it->second;
             if (av_name.mExpires < max_unrefreshed)
@@ -572,12 +575,12 @@ void LLAvatarNameCache::eraseUnrefreshed()
                                          << " user '" << av_name.getAccountName() << "' "
                                          << "expired " << now - av_name.mExpires << " secs ago"
                                          << LL_ENDL;
-                sCache.erase(it++);
+                expired.push_back(it->first);
             }
-			else
-			{
-				++it;
-			}
+        }
+        for (std::vector<LLUUID>::iterator it = expired.begin(); it != expired.end(); ++it)
+        {
+            sCache.erase(*it);
         }
         LL_INFOS("AvNameCache") << sCache.size() << " cached avatar names" << LL_ENDL;
 	}
@@ -590,7 +593,7 @@ bool LLAvatarNameCache::get(const LLUUID& agent_id, LLAvatarName *av_name)
 	if (sRunning)
 	{
 		// ...only do immediate lookups when cache is running
-		std::map<LLUUID,LLAvatarName>::iterator it = sCache.find(agent_id);
+		cache_t::iterator it = sCache.find(agent_id);
 		if (it != sCache.end())
 		{
 			*av_name = it->second;
@@ -664,10 +667,11 @@ LLAvatarNameCache::callback_connection_t LLAvatarNameCache::get(const LLUUID& ag
 	if (sRunning)
 	{
 		// ...only do immediate lookups when cache is running
-		std::map<LLUUID,LLAvatarName>::iterator it = sCache.find(agent_id);
+		cache_t::iterator it = sCache.find(agent_id);
 		if (it != sCache.end())
 		{
-			const LLAvatarName& av_name = it->second;
+			// Copy the name: the callback may add names to sCache, which can move its entries.
+			const LLAvatarName av_name = it->second;
 			
 			if (av_name.mExpires > LLFrameTimer::getTotalSeconds())
 			{
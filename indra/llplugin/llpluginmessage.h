@@ -85,11 +85,16 @@ public:
 	// get the value of a key as a pointer.
 	void* getValuePointer(const std::string &key) const;
 
-	// Flatten the message into a string
+	// Flatten the message into a string (LLSD XML, as passed to and from plugin DSOs)
 	std::string generate(void) const;
 
+	// Flatten the message into binary LLSD, as sent over the message pipe between
+	// the viewer and SLPlugin. Much cheaper to generate and parse than XML.
+	std::string generateBinary(void) const;
+
 	// Parse an incoming message into component parts
 	// (this clears out all existing state before starting the parse)
+	// Accepts both the XML and the binary form.
 	// Returns -1 on failure, otherwise returns the number of key/value pairs in the message.
 	int parse(const std::string &message);
 
@@ -33,7 +33,9 @@
 
 #include "llapr.h"
 
-static const char MESSAGE_DELIMITER = '\0';
+// Every message on the pipe is preceded by its length, as four bytes, least significant first.
+// Messages are binary LLSD, so they can contain any byte value.
+static const size_t MESSAGE_HEADER_SIZE = 4;
 
 LLPluginMessagePipeOwner::LLPluginMessagePipeOwner() :
 	mMessagePipe(NULL),
@@ -121,9 +123,15 @@ bool LLPluginMessagePipe::addMessage(const std::string &message)
 {
 	// queue the message for later output
 	//LLMutexLock lock(&mOutputMutex);
+	U32 size = (U32)message.size();
+	char header[MESSAGE_HEADER_SIZE];
+	header[0] = (char)(size & 0xFF);
+	header[1] = (char)((size >> 8) & 0xFF);
+	header[2] = (char)((size >> 16) & 0xFF);
+	header[3] = (char)((size >> 24) & 0xFF);
 	mOutputMutex.lock();
+	mOutput.append(header, MESSAGE_HEADER_SIZE);
 	mOutput += message;
-	mOutput += MESSAGE_DELIMITER;	// message separator
 	mOutputMutex.unlock();
 	return true;
 }
@@ -202,14 +210,14 @@ bool LLPluginMessagePipe::pumpOutput(bool flush)
 			if(status == APR_SUCCESS)
 			{
 				// success
-				mOutput = mOutput.substr(size);
+				mOutput.erase(0, size);
 				break;
 			}
 			else if(APR_STATUS_IS_EAGAIN(status) || APR_STATUS_IS_TIMEUP(status))
 			{
 				// Socket buffer is full... 
 				// remove the written part from the buffer and try again later.
-				mOutput = mOutput.substr(size);
+				mOutput.erase(0, size);
 				if (!flush)
 					break;
 				flush_time_left_usec -= timeout_usec;
@@ -281,7 +289,7 @@ bool LLPluginMessagePipe::pumpInput(F64 timeout)
 		// Check for incoming messages
 		if(result)
 		{
-			char input_buf[1024];
+			char input_buf[8192];
 			apr_size_t request_size;
 			
 			if(timeout == 0.0f)
@@ -385,19 +393,26 @@ bool LLPluginMessagePipe::pumpInput(F64 timeout)
 
 void LLPluginMessagePipe::processInput(void)
 {
-	// Look for input delimiter(s) in the input buffer.
-	int delim;
+	// Look for complete message(s) in the input buffer.
 	mInputMutex.lock();
-	while((delim = mInput.find(MESSAGE_DELIMITER)) != std::string::npos)
+	while(mInput.size() >= MESSAGE_HEADER_SIZE)
 	{	
+		const U8* header = (const U8*)mInput.data();
+		size_t size = (size_t)header[0] | ((size_t)header[1] << 8) | ((size_t)header[2] << 16) | ((size_t)header[3] << 24);
+		if (mInput.size() < MESSAGE_HEADER_SIZE + size)
+		{
+			// Wait for the rest of the message.
+			break;
+		}
+
 		// Let the owner process this message
 		if (mOwner)
 		{
 			// Pull the message out of the input buffer before calling receiveMessageRaw.
 			// It's now possible for this function to get called recursively (in the case where the plugin makes a blocking request)
 			// and this guarantees that the messages will get dequeued correctly.
-			std::string message(mInput, 0, delim);
-			mInput.erase(0, delim + 1);
+			std::string message(mInput, MESSAGE_HEADER_SIZE, size);
+			mInput.erase(0, MESSAGE_HEADER_SIZE + size);
 			mInputMutex.unlock();
 			mOwner->receiveMessageRaw(message);
 			mInputMutex.lock();
@@ -405,6 +420,7 @@ void LLPluginMessagePipe::processInput(void)
 		else
 		{
 			LL_WARNS("Plugin") << "!mOwner" << LL_ENDL;
+			break;
 		}
 	}
 	mInputMutex.unlock();
@@ -310,9 +310,9 @@ void LLPluginProcessChild::sendMessageToPlugin(const LLPluginMessage &message)
 // This function is called by SLPlugin to send 'message' to the viewer (the parent process).
 void LLPluginProcessChild::sendMessageToParent(const LLPluginMessage &message)
 {
-	std::string buffer = message.generate();
+	std::string buffer = message.generateBinary();
 
-	LL_DEBUGS("Plugin") << "Sending to parent: " << buffer << LL_ENDL;
+	LL_DEBUGS("Plugin") << "Sending to parent: " << message.generate() << LL_ENDL;
 
 	// Write the serialized message to the pipe.
 	writeMessageRaw(buffer);
@@ -328,12 +328,12 @@ void LLPluginProcessChild::receiveMessageRaw(const std::string &message)
 {
 	// Incoming message from the TCP Socket
 
-	LL_DEBUGS("Plugin") << "Received from parent: " << message << LL_ENDL;
-
 	// Decode this message
 	LLPluginMessage parsed;
 	parsed.parse(message);
 
+	LL_DEBUGS("Plugin") << "Received from parent: " << parsed.generate() << LL_ENDL;
+
 	if(mBlockingRequest)
 	{
 		// We're blocking the plugin waiting for a response.
@@ -454,7 +454,8 @@ void LLPluginProcessChild::receiveMessageRaw(const std::string &message)
 	{
 		LLTimer elapsed;
 
-		mInstance->sendMessage(message);
+		// Plugin DSOs receive messages as (null terminated) XML.
+		mInstance->sendMessage(parsed.generate());
 
 		mCPUElapsed += elapsed.getElapsedTimeF64();
 	}
@@ -486,12 +487,12 @@ void LLPluginProcessChild::receivePluginMessage(const std::string &message)
 
 	// FIXME: how should we handle queueing here?
 	
+	// Decode this message
+	LLPluginMessage parsed;
+	parsed.parse(message);
+
 	// Intercept certain base messages (responses to ones sent by this class)
 	{
-		// Decode this message
-		LLPluginMessage parsed;
-		parsed.parse(message);
-		
 		if(parsed.hasValue("blocking_request"))
 		{
 			mBlockingRequest = true;
@@ -573,7 +574,7 @@ void LLPluginProcessChild::receivePluginMessage(const std::string &message)
 	if(passMessage)
 	{
 		LL_DEBUGS("Plugin") << "Passing through to parent: " << message << LL_ENDL;
-		writeMessageRaw(message);
+		writeMessageRaw(parsed.generateBinary());
 	}
 	
 	while(mBlockingRequest)
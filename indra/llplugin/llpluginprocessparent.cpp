@@ -629,15 +629,15 @@ void LLPluginProcessParent::sendMessage(const LLPluginMessage &message)
 		mBlocked = true;
 	}
 	
-	std::string buffer = message.generate();
+	std::string buffer = message.generateBinary();
 #if LL_DEBUG
 	if (message.getName() == "mouse_event")
 	{
-		LL_DEBUGS("PluginMouseEvent") << "Sending: " << buffer << LL_ENDL;
+		LL_DEBUGS("PluginMouseEvent") << "Sending: " << message.generate() << LL_ENDL;
 	}
 	else
 	{
-		LL_DEBUGS("Plugin") << "Sending: " << buffer << LL_ENDL;
+		LL_DEBUGS("Plugin") << "Sending: " << message.generate() << LL_ENDL;
 	}
 #endif
 	writeMessageRaw(buffer);
@@ -917,11 +917,11 @@ void LLPluginProcessParent::servicePoll()
 // It parses the message and passes it on to LLPluginProcessParent::receiveMessage.
 void LLPluginProcessParent::receiveMessageRaw(const std::string &message)
 {
-	LL_DEBUGS("PluginRaw") << "Received: " << message << LL_ENDL;
-	
 	LLPluginMessage parsed;
 	if(parsed.parse(message) != -1)
 	{
+		LL_DEBUGS("PluginRaw") << "Received: " << parsed.generate() << LL_ENDL;
+
 		if(parsed.hasValue("blocking_request"))
 		{
 			mBlocked = true;
@@ -32,6 +32,10 @@
 #include "llsdserialize.h"
 #include "llvector4a.h"
 #include "llmatrix4a.h"
+#include "llatomic.h"
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#include <boost/thread/thread.hpp>
 #if LL_MSVC
 #pragma warning (push)
 #pragma warning (disable : 4068)
@@ -958,16 +962,7 @@ BOOL LLModel::createVolumeFacesFromDomMesh(domMesh* mesh)
 
 		addVolumeFacesFromDomMesh(mesh);
 		
-		if (getNumVolumeFaces() > 0)
-		{
-			normalizeVolumeFaces();
-			optimizeVolumeFaces();
-			
-			if (getNumVolumeFaces() > 0)
-			{
-				return TRUE;
-			}
-		}
+		return finalizeVolumeFaces();
 	}
 	else
 	{	
@@ -977,6 +972,22 @@ BOOL LLModel::createVolumeFacesFromDomMesh(domMesh* mesh)
 	return FALSE;
 }
 
+BOOL LLModel::finalizeVolumeFaces()
+{
+	if (getNumVolumeFaces() > 0)
+	{
+		normalizeVolumeFaces();
+		optimizeVolumeFaces();
+		
+		if (getNumVolumeFaces() > 0)
+		{
+			return TRUE;
+		}
+	}
+
+	return FALSE;
+}
+
 void LLModel::offsetMesh( const LLVector3& pivotPoint )
 {
 	LLVector4a pivot( pivotPoint[VX], pivotPoint[VY], pivotPoint[VZ] );
@@ -1539,6 +1550,76 @@ LLModel* LLModel::loadModelFromDomMesh(domMesh *mesh)
 	return ret;
 }
 
+namespace
+{
+	typedef boost::function<void (LLModel*)> model_func_t;
+
+	void model_worker(const std::vector<LLPointer<LLModel> >& models, const model_func_t& func, LLAtomicU32& next)
+	{
+		for (U32 i = next++; i < models.size(); i = next++)
+		{
+			func(models[i]);
+		}
+	}
+
+	// Calls func on every model, with the models spread over up to max_threads
+	// threads (0 = one per core). Returns once all models are done.
+	void for_each_model(const std::vector<LLPointer<LLModel> >& models, const model_func_t& func, U32 max_threads)
+	{
+		U32 threads = max_threads ? max_threads : boost::thread::hardware_concurrency();
+		threads = llmin(threads, (U32) models.size());
+
+		LLAtomicU32 next(0);
+		boost::thread_group workers;
+		for (U32 i = 1; i < threads; ++i)
+		{
+			workers.create_thread(boost::bind(&model_worker, boost::cref(models), boost::cref(func), boost::ref(next)));
+		}
+		model_worker(models, func, next);
+		workers.join_all();
+	}
+
+	void finalize_model(LLModel* model)
+	{
+		if (model->getStatus() == LLModel::NO_ERRORS)
+		{
+			model->finalizeVolumeFaces();
+		}
+	}
+
+	void generate_model_normals(LLModel* model, F32 angle_cutoff)
+	{
+		model->generateNormals(angle_cutoff);
+	}
+}
+
+//static
+void LLModel::loadModelsFromDomMeshes(const std::vector<domMesh*>& meshes, std::vector<LLPointer<LLModel> >& models, U32 max_threads)
+{
+	models.clear();
+	models.reserve(meshes.size());
+
+	// The DOM is not safe to read from several threads, so the geometry is
+	// read here; only the per-model post-processing runs in parallel.
+	for (U32 i = 0; i < meshes.size(); ++i)
+	{
+		LLVolumeParams volume_params;
+		volume_params.setType(LL_PCODE_PROFILE_SQUARE, LL_PCODE_PATH_LINE);
+		LLModel* model = new LLModel(volume_params, 0.f);
+		model->addVolumeFacesFromDomMesh(meshes[i]);
+		model->mLabel = getElementLabel(meshes[i]);
+		models.push_back(model);
+	}
+
+	for_each_model(models, &finalize_model, max_threads);
+}
+
+//static
+void LLModel::generateNormals(const std::vector<LLPointer<LLModel> >& models, F32 angle_cutoff, U32 max_threads)
+{
+	for_each_model(models, boost::bind(&generate_model_normals, _1, angle_cutoff), max_threads);
+}
+
 std::string LLModel::getName() const
 {
 	if (!mRequestedLabel.empty())
@@ -146,6 +146,10 @@ public:
 		BOOL nowrite = FALSE, BOOL as_slm = FALSE);
 
 	static LLModel* loadModelFromDomMesh(domMesh* mesh);
+	// Reads the geometry of each mesh in order on the calling thread, then
+	// normalizes and optimizes the resulting models on up to max_threads
+	// threads (0 = one per core). models[i] is the model for meshes[i].
+	static void loadModelsFromDomMeshes(const std::vector<domMesh*>& meshes, std::vector<LLPointer<LLModel> >& models, U32 max_threads = 0);
 	static std::string getElementLabel(daeElement* element);
 	std::string getName() const;
 	std::string getMetric() const {return mMetric;}
@@ -166,11 +170,15 @@ public:
 		U32 num_indices);
 
 	void generateNormals(F32 angle_cutoff);
+	// Same as above for a set of models, spreading them over up to max_threads threads.
+	static void generateNormals(const std::vector<LLPointer<LLModel> >& models, F32 angle_cutoff, U32 max_threads = 0);
 
 	void addFace(const LLVolumeFace& face);
 
 	void normalizeVolumeFaces();
 	void optimizeVolumeFaces();
+	// normalizes and optimizes freshly read faces, returns FALSE if none are left
+	BOOL finalizeVolumeFaces();
 	void offsetMesh( const LLVector3& pivotPoint );
 	void getNormalizedScaleTranslation(LLVector3& scale_out, LLVector3& translation_out);
 	LLVector3 getTransformedCenter(const LLMatrix4& mat);
@@ -114,6 +114,7 @@ LLFontFreetype::LLFontFreetype()
 	mAddGlyphCount(0),
 	mPointSize(0)
 {
+	memset(mGlyphPages, 0, sizeof(mGlyphPages));
 }
 
 
@@ -125,6 +126,7 @@ LLFontFreetype::~LLFontFreetype()
 	mFTFace = NULL;
 
 	// Delete glyph info
+	clearGlyphPages();
 	std::for_each(mCharGlyphInfoMap.begin(), mCharGlyphInfoMap.end(), DeletePairedPointer());
 
 	// mFontBitmapCachep will be cleaned up by LLPointer destructor.
@@ -443,6 +445,15 @@ LLFontGlyphInfo* LLFontFreetype::addGlyphFromFont(const LLFontFreetype *fontp, l
 
 LLFontGlyphInfo* LLFontFreetype::getGlyphInfo(llwchar wch) const
 {
+	if (wch < 0x10000)
+	{
+		LLFontGlyphInfo** page = mGlyphPages[wch / GLYPH_PAGE_SIZE];
+		if (page && page[wch % GLYPH_PAGE_SIZE])
+		{
+			return page[wch % GLYPH_PAGE_SIZE];
+		}
+	}
+
 	char_glyph_info_map_t::iterator iter = mCharGlyphInfoMap.find(wch);
 	if (iter != mCharGlyphInfoMap.end())
 	{
@@ -467,6 +478,26 @@ void LLFontFreetype::insertGlyphInfo(llwchar wch, LLFontGlyphInfo* gi) const
 	{
 		mCharGlyphInfoMap[wch] = gi;
 	}
+
+	if (wch < 0x10000)
+	{
+		LLFontGlyphInfo**& page = mGlyphPages[wch / GLYPH_PAGE_SIZE];
+		if (!page)
+		{
+			page = new LLFontGlyphInfo*[GLYPH_PAGE_SIZE];
+			memset(page, 0, GLYPH_PAGE_SIZE * sizeof(LLFontGlyphInfo*));
+		}
+		page[wch % GLYPH_PAGE_SIZE] = gi;
+	}
+}
+
+void LLFontFreetype::clearGlyphPages() const
+{
+	for (S32 i = 0; i < NUM_GLYPH_PAGES; ++i)
+	{
+		delete [] mGlyphPages[i];
+		mGlyphPages[i] = NULL;
+	}
 }
 
 void LLFontFreetype::renderGlyph(const U32 glyph_index) const
@@ -507,6 +538,7 @@ void LLFontFreetype::reset(F32 vert_dpi, F32 horz_dpi)
 
 void LLFontFreetype::resetBitmapCache()
 {
+	clearGlyphPages();
 	for_each(mCharGlyphInfoMap.begin(), mCharGlyphInfoMap.end(), DeletePairedPointer());
 	mCharGlyphInfoMap.clear();
 	
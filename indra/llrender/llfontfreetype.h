@@ -169,6 +169,13 @@ private:
 	typedef boost::unordered_map<llwchar, LLFontGlyphInfo*> char_glyph_info_map_t;
 	mutable char_glyph_info_map_t mCharGlyphInfoMap; // Information about glyph location in bitmap
 
+	// Direct lookup for the Basic Multilingual Plane: 256 lazily allocated pages
+	// of 256 glyphs each, indexed by the high and low byte of the character.
+	// Entries are not owned; mCharGlyphInfoMap is.
+	enum { GLYPH_PAGE_SIZE = 256, NUM_GLYPH_PAGES = 0x10000 / GLYPH_PAGE_SIZE };
+	void clearGlyphPages() const;
+	mutable LLFontGlyphInfo** mGlyphPages[NUM_GLYPH_PAGES];
+
 	mutable LLPointer<LLFontBitmapCache> mFontBitmapCachep;
 
 	mutable S32 mRenderGlyphCount;
@@ -79,6 +79,15 @@ inline BOOL LLKeywordToken::isTail(const llwchar* s) const
 	return res;
 }
 
+const LLStyleSP& LLKeywordToken::getStyle() const
+{
+	if (mStyle.isNull())
+	{
+		mStyle = new LLStyle(TRUE, mColor, LLStringUtil::null);
+	}
+	return mStyle;
+}
+
 LLKeywords::~LLKeywords()
 {
 	std::for_each(mWordTokenMap.begin(), mWordTokenMap.end(), DeletePairedPointer());
@@ -244,16 +253,22 @@ void LLKeywords::addToken(LLKeywordToken::TOKEN_TYPE type,
 	{
 	case LLKeywordToken::WORD:
 		mWordTokenMap[key] = new LLKeywordToken(type, color, key, tool_tip, LLWStringUtil::null);
+		mWordTrie.add(key, mTrieTokens.size());
+		mTrieTokens.push_back(mWordTokenMap[key]);
 		break;
 
 	case LLKeywordToken::LINE:
 		mLineTokenList.push_front(new LLKeywordToken(type, color, key, tool_tip, LLWStringUtil::null));
+		mLineTrie.add(key, mTrieTokens.size());
+		mTrieTokens.push_back(mLineTokenList.front());
 		break;
 
 	case LLKeywordToken::TWO_SIDED_DELIMITER:
 	case LLKeywordToken::DOUBLE_QUOTATION_MARKS:
 	case LLKeywordToken::ONE_SIDED_DELIMITER:
 		mDelimiterTokenList.push_front(new LLKeywordToken(type, color, key, tool_tip, delimiter));
+		mDelimiterTrie.add(key, mTrieTokens.size());
+		mTrieTokens.push_back(mDelimiterTokenList.front());
 		break;
 
 	default:
@@ -369,11 +384,131 @@ void LLKeywords::findSegments(std::vector<LLTextSegmentPtr>* seg_list, const LLW
 	
 	S32 text_len = wtext.size();
 
-	seg_list->push_back( new LLTextSegment( LLColor3(defaultColor), 0, text_len ) ); 
+	// Roughly one token (plus the default run after it) per ten characters.
+	seg_list->reserve(text_len / 5 + 1);
+	LLStyleSP default_style = new LLStyle(TRUE, defaultColor, LLStringUtil::null);
+	seg_list->push_back( new LLTextSegment( default_style, 0, text_len ) ); 
+
+	scanSegments(seg_list, wtext, 0, default_style, NULL, 0, 0);
+}
+
+S32 LLKeywords::updateSegments(std::vector<LLTextSegmentPtr>* seg_list, const LLWString& wtext, const LLColor4 &defaultColor,
+							   S32 damage_start, S32 damage_end, S32 delta)
+{
+	LLFastTimer ft(FTM_SYNTAX_COLORING);
+
+	S32 text_len = wtext.size();
+	if (text_len == 0)
+	{
+		seg_list->clear();
+		return 0;
+	}
+
+	std::vector<LLTextSegmentPtr> old_list;
+	old_list.swap(*seg_list);
+
+	// Back up to a line start that the old scan did not cross in the middle
+	// of a token (a multi-line comment or string, typically). Everything
+	// before it is unaffected by the edit.
+	S32 start = llclamp(damage_start, 0, text_len);
+	size_t keep = 0;
+	while (true)
+	{
+		while (start > 0 && wtext[start - 1] != '\n')
+		{
+			--start;
+		}
+		if (start == 0)
+		{
+			keep = 0;
+			break;
+		}
+		LLTextSegment key(start - 1);
+		keep = std::upper_bound(old_list.begin(), old_list.end(), &key, LLTextSegment::compare()) - old_list.begin();
+		if (keep == 0)
+		{
+			start = 0;
+			break;
+		}
+		const LLTextSegment* last = old_list[keep - 1];
+		if (last->getToken() && last->getEnd() > start)
+		{
+			start = last->getStart();
+			continue;
+		}
+		break;
+	}
+
+	seg_list->reserve(old_list.size() + 16);
+	seg_list->assign(old_list.begin(), old_list.begin() + keep);
+	LLStyleSP default_style = new LLStyle(TRUE, defaultColor, LLStringUtil::null);
+	if (seg_list->empty())
+	{
+		seg_list->push_back( new LLTextSegment( default_style, 0, text_len ) );
+	}
+	else if (seg_list->back()->getToken())
+	{
+		seg_list->push_back( new LLTextSegment( default_style, seg_list->back()->getEnd(), text_len ) );
+	}
+	else
+	{
+		// Replace rather than stretch the default run we stopped in: the
+		// old list still needs its original extent for resyncing.
+		S32 seg_start = seg_list->back()->getStart();
+		seg_list->back() = new LLTextSegment( default_style, seg_start, text_len );
+	}
+
+	return scanSegments(seg_list, wtext, start, default_style, &old_list, damage_end, delta);
+}
+
+// Once the scan is past the damage and reaches a line boundary that was also
+// outside of any token in the old scan, the rest of the old segments are still
+// right, only shifted by delta.
+bool LLKeywords::resyncSegments(std::vector<LLTextSegmentPtr>& seg_list, const std::vector<LLTextSegmentPtr>& old_list,
+								S32 pos, S32 delta)
+{
+	LLTextSegment key(pos - delta);
+	std::vector<LLTextSegmentPtr>::const_iterator iter =
+		std::upper_bound(old_list.begin(), old_list.end(), &key, LLTextSegment::compare());
+	if (iter == old_list.begin())
+	{
+		return false;
+	}
+	--iter;
+	LLTextSegment* old_seg = *iter;
+	if (old_seg->getToken() || old_seg->getEnd() <= pos - delta)
+	{
+		return false;
+	}
+
+	// Both scans are in a default colored run here; merge the two.
+	seg_list.back()->setEnd(old_seg->getEnd() + delta);
+	for (++iter; iter != old_list.end(); ++iter)
+	{
+		LLTextSegment* seg = *iter;
+		if (delta)
+		{
+			seg->setStart(seg->getStart() + delta);
+			seg->setEnd(seg->getEnd() + delta);
+		}
+		seg_list.push_back(seg);
+	}
+	return true;
+}
+
+// Scans from 'start', which must be 0 or the start of a line, appending to
+// seg_list. When old_list is given, stops at the first chance to reuse it
+// past 'resync_after'. Returns where the scan stopped.
+S32 LLKeywords::scanSegments(std::vector<LLTextSegmentPtr>* seg_list, const LLWString& wtext, S32 start, const LLStyleSP& default_style,
+							 const std::vector<LLTextSegmentPtr>* old_list, S32 resync_after, S32 delta)
+{
+	S32 text_len = wtext.size();
 
 	const llwchar* base = wtext.c_str();
-	const llwchar* cur = base;
-	//const llwchar* line = NULL;
+	const llwchar* end = base + text_len;
+	// Resume on the newline that ends the previous line, so the scan starts
+	// in the same state a full scan would be in there.
+	const llwchar* cur = start > 0 ? base + start - 1 : base;
 
 	while( *cur )
 	{
@@ -381,6 +516,11 @@ void LLKeywords::findSegments(std::vector<LLTextSegmentPtr>* seg_list, const LLW
 		{
 			if( *cur == '\n' )
 			{
+				if (old_list && (cur - base) >= resync_after &&
+					resyncSegments(*seg_list, *old_list, cur - base, delta))
+				{
+					return cur - base;
+				}
 				cur++;
 				if( !*cur || *cur == '\n' )
 				{
@@ -404,34 +544,22 @@ void LLKeywords::findSegments(std::vector<LLTextSegmentPtr>* seg_list, const LLW
 			// cur is now at the first non-whitespace character of a new line	
 		
 			// Line start tokens
+			S32 line_token = mLineTrie.matchPrefix(cur, end);
+			if( line_token >= 0 )
 			{
-				BOOL line_done = FALSE;
-				for (token_list_t::iterator iter = mLineTokenList.begin();
-					 iter != mLineTokenList.end(); ++iter)
+				LLKeywordToken* cur_token = mTrieTokens[line_token];
+				S32 seg_start = cur - base;
+				while( *cur && *cur != '\n' )
 				{
-					LLKeywordToken* cur_token = *iter;
-					if( cur_token->isHead( cur ) )
-					{
-						S32 seg_start = cur - base;
-						while( *cur && *cur != '\n' )
-						{
-							// skip the rest of the line
-							cur++;
-						}
-						S32 seg_end = cur - base;
-						
-						LLTextSegmentPtr text_segment = new LLTextSegment( cur_token->getColor(), seg_start, seg_end );
-						text_segment->setToken( cur_token );
-						insertSegment( *seg_list, text_segment, text_len, defaultColor);
-						line_done = TRUE; // to break out of second loop.
-						break;
-					}
+					// skip the rest of the line
+					cur++;
 				}
+				S32 seg_end = cur - base;
 
-				if( line_done )
-				{
-					continue;
-				}
+				LLTextSegmentPtr text_segment = new LLTextSegment( cur_token->getStyle(), seg_start, seg_end );
+				text_segment->setToken( cur_token );
+				insertSegment( *seg_list, text_segment, text_len, default_style);
+				continue;
 			}
 		}
 
@@ -446,17 +574,8 @@ void LLKeywords::findSegments(std::vector<LLTextSegmentPtr>* seg_list, const LLW
 			// Check against delimiters
 			{
 				S32 seg_start = 0;
-				LLKeywordToken* cur_delimiter = NULL;
-				for (token_list_t::iterator iter = mDelimiterTokenList.begin();
-					 iter != mDelimiterTokenList.end(); ++iter)
-				{
-					LLKeywordToken* delimiter = *iter;
-					if( delimiter->isHead( cur ) )
-					{
-						cur_delimiter = delimiter;
-						break;
-					}
-				}
+				S32 delimiter_token = mDelimiterTrie.matchPrefix(cur, end);
+				LLKeywordToken* cur_delimiter = delimiter_token >= 0 ? mTrieTokens[delimiter_token] : NULL;
 
 				if( cur_delimiter )
 				{
@@ -530,9 +649,9 @@ void LLKeywords::findSegments(std::vector<LLTextSegmentPtr>* seg_list, const LLW
 					}
 
 
-					LLTextSegmentPtr text_segment = new LLTextSegment( cur_delimiter->getColor(), seg_start, seg_end );
+					LLTextSegmentPtr text_segment = new LLTextSegment( cur_delimiter->getStyle(), seg_start, seg_end );
 					text_segment->setToken( cur_delimiter );
-					insertSegment( *seg_list, text_segment, text_len, defaultColor);
+					insertSegment( *seg_list, text_segment, text_len, default_style);
 
 					// Note: we don't increment cur, since the end of one delimited seg may be immediately
 					// followed by the start of another one.
@@ -544,28 +663,33 @@ void LLKeywords::findSegments(std::vector<LLTextSegmentPtr>* seg_list, const LLW
 			llwchar prev = cur > base ? *(cur-1) : 0;
 			if( !isalnum( prev ) && (prev != '_') && (prev != '#'))
 			{
+				// Find the end of the word and walk the keyword trie in the same pass.
 				const llwchar* p = cur;
+				LLAhoCorasick<llwchar>::node_t node = LLAhoCorasick<llwchar>::ROOT;
 				while( isalnum( *p ) || (*p == '_') || (*p == '#') )
 				{
+					if (node != LLAhoCorasick<llwchar>::NO_NODE)
+					{
+						node = mWordTrie.child(node, *p);
+					}
 					p++;
 				}
 				S32 seg_len = p - cur;
 				if( seg_len > 0 )
 				{
-					WStringMapIndex word( cur, seg_len );
-					word_token_map_t::iterator map_iter = mWordTokenMap.find(word);
-					if( map_iter != mWordTokenMap.end() )
+					S32 word_token = node != LLAhoCorasick<llwchar>::NO_NODE ? mWordTrie.value(node) : -1;
+					if( word_token >= 0 )
 					{
-						LLKeywordToken* cur_token = map_iter->second;
+						LLKeywordToken* cur_token = mTrieTokens[word_token];
 						S32 seg_start = cur - base;
 						S32 seg_end = seg_start + seg_len;
 
 						// llinfos << "Seg: [" << word.c_str() << "]" << llendl;
 
 
-						LLTextSegmentPtr text_segment = new LLTextSegment( cur_token->getColor(), seg_start, seg_end );
+						LLTextSegmentPtr text_segment = new LLTextSegment( cur_token->getStyle(), seg_start, seg_end );
 						text_segment->setToken( cur_token );
-						insertSegment( *seg_list, text_segment, text_len, defaultColor);
+						insertSegment( *seg_list, text_segment, text_len, default_style);
 					}
 					cur += seg_len; 
 					continue;
@@ -578,9 +702,10 @@ void LLKeywords::findSegments(std::vector<LLTextSegmentPtr>* seg_list, const LLW
 			}
 		}
 	}
+	return text_len;
 }
 
-void LLKeywords::insertSegment(std::vector<LLTextSegmentPtr>& seg_list, LLTextSegmentPtr new_segment, S32 text_len, const LLColor4 &defaultColor )
+void LLKeywords::insertSegment(std::vector<LLTextSegmentPtr>& seg_list, LLTextSegmentPtr new_segment, S32 text_len, const LLStyleSP& default_style )
 {
 	LLTextSegmentPtr last = seg_list.back();
 	S32 new_seg_end = new_segment->getEnd();
@@ -598,7 +723,7 @@ void LLKeywords::insertSegment(std::vector<LLTextSegmentPtr>& seg_list, LLTextSe
 
 	if( new_seg_end < text_len )
 	{
-		seg_list.push_back( new LLTextSegment( defaultColor, new_seg_end, text_len ) );
+		seg_list.push_back( new LLTextSegment( default_style, new_seg_end, text_len ) );
 	}
 }
 
@@ -39,7 +39,9 @@
 #include <map>
 #include <list>
 #include <deque>
+#include "llahocorasick.h"
 #include "llpointer.h"
+#include "llstyle.h"
 
 class LLTextSegment;
 typedef LLPointer<LLTextSegment> LLTextSegmentPtr;
@@ -85,6 +87,8 @@ public:
 	TOKEN_TYPE			getType()  const		{ return mType; }
 	const LLWString&	getToolTip() const		{ return mToolTip; }
 	const LLWString&	getDelimiter() const	{ return mDelimiter; }
+	// Shared by all the segments highlighted with this token.
+	const LLStyleSP&	getStyle() const;
 
 #ifdef _DEBUG
 	void		dump();
@@ -96,6 +100,7 @@ private:
 	LLColor3	mColor;
 	LLWString	mToolTip;
 	LLWString	mDelimiter;
+	mutable LLStyleSP	mStyle;
 };
 
 class LLKeywords
@@ -108,6 +113,13 @@ public:
 	BOOL		isLoaded() const	{ return mLoaded; }
 
 	void		findSegments(std::vector<LLTextSegmentPtr> *seg_list, const LLWString& text, const LLColor4 &defaultColor );
+	// Re-highlights text after an edit, given the segments found before it.
+	// [damage_start, damage_end) is the changed range in the new text and delta
+	// the change in length. Only the damaged lines are scanned; the old segments
+	// past them are shifted and reused. Returns the position from which they
+	// were reused (the text length if they weren't).
+	S32			updateSegments(std::vector<LLTextSegmentPtr> *seg_list, const LLWString& text, const LLColor4 &defaultColor,
+							   S32 damage_start, S32 damage_end, S32 delta);
 
 	// Add the token as described
 	void addToken(LLKeywordToken::TOKEN_TYPE type,
@@ -121,7 +133,8 @@ public:
 	// This worked, but caused a performance bottleneck due to memory allocation and string copies
 	//  because it's not possible to search such a map without creating an LLWString.
 	// Using this class as the map index instead allows us to search using segments of an existing
-	//  text run without copying them first, which greatly reduces overhead in LLKeywords::findSegments().
+	//  text run without copying them first.
+	// Highlighting looks words up in mWordTrie instead; this map is what lists the keywords.
 	class WStringMapIndex
 	{
 	public:
@@ -152,13 +165,23 @@ public:
 
 private:
 	LLColor3	readColor(const std::string& s);
-	void		insertSegment(std::vector<LLTextSegmentPtr>& seg_list, LLTextSegmentPtr new_segment, S32 text_len, const LLColor4 &defaultColor);
+	void		insertSegment(std::vector<LLTextSegmentPtr>& seg_list, LLTextSegmentPtr new_segment, S32 text_len, const LLStyleSP& default_style);
+	S32			scanSegments(std::vector<LLTextSegmentPtr>* seg_list, const LLWString& text, S32 start, const LLStyleSP& default_style,
+							 const std::vector<LLTextSegmentPtr>* old_list, S32 resync_after, S32 delta);
+	bool		resyncSegments(std::vector<LLTextSegmentPtr>& seg_list, const std::vector<LLTextSegmentPtr>& old_list, S32 pos, S32 delta);
 
 	BOOL		mLoaded;
 	word_token_map_t mWordTokenMap;
 	typedef std::deque<LLKeywordToken*> token_list_t;
 	token_list_t mLineTokenList;
 	token_list_t mDelimiterTokenList;
+
+	// Every token in the order added, indexed by the values stored in the
+	// tries below. Later tokens win over earlier ones, as they do above.
+	std::vector<LLKeywordToken*> mTrieTokens;
+	LLAhoCorasick<llwchar> mWordTrie;
+	LLAhoCorasick<llwchar> mLineTrie;
+	LLAhoCorasick<llwchar> mDelimiterTrie;
 };
 
 #endif  // LL_LLKEYWORDS_H
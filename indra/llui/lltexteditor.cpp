@@ -294,6 +294,7 @@ LLTextEditor::LLTextEditor(
 	mLastContextMenuY(-1),
 	mReflowNeeded(FALSE),
 	mScrollNeeded(FALSE),
+	mLayoutWidth(-1),
 	mSpellCheckable(FALSE)
 {
 	mSourceID.generate();
@@ -500,88 +501,126 @@ void LLTextEditor::setShadowColor( const LLColor4& color )
 }
 
 void LLTextEditor::updateLineStartList(S32 startpos)
+{
+	mLayoutDamage.include(startpos, S32_MAX);
+	reflow();
+}
+
+static LLFastTimer::DeclareTimer FTM_TEXT_REFLOW("Text Reflow");
+
+// Re-wraps the lines touched by the changes recorded in mLayoutDamage.
+void LLTextEditor::reflow()
 {
 	updateSegments();
-	
-	bindEmbeddedChars(mGLFont);
 
-	S32 seg_num = mSegments.size();
-	S32 seg_idx = 0;
-	S32 seg_offset = 0;
+	if (mLayoutWidth != mTextRect.getWidth())
+	{
+		mLayoutDamage.setAll();
+		mLayoutWidth = mTextRect.getWidth();
+	}
 
-	if (!mLineStartList.empty())
+	if (!mLayoutDamage.isEmpty())
 	{
-		getSegmentAndOffset(startpos, &seg_idx, &seg_offset);
-		line_info t(seg_idx, seg_offset);
-		line_list_t::iterator iter = std::upper_bound(mLineStartList.begin(), mLineStartList.end(), t, line_info_compare());
-		if (iter != mLineStartList.begin()) --iter;
-		seg_idx = iter->mSegment;
-		seg_offset = iter->mOffset;
+		LLFastTimer ft(FTM_TEXT_REFLOW);
+		bindEmbeddedChars(mGLFont);
+
+		// Wrapping carries nothing over a hard line break, so start at the
+		// beginning of the paragraph with the first change in it.
+		S32 startpos = llclamp(mLayoutDamage.mStart, 0, getLength());
+		while (startpos > 0 && mWText[startpos - 1] != '\n')
+		{
+			--startpos;
+		}
+		line_list_t::iterator iter = std::lower_bound(mLineStartList.begin(), mLineStartList.end(), startpos);
+		line_list_t old_lines(iter, mLineStartList.end());
 		mLineStartList.erase(iter, mLineStartList.end());
-	}
-	
-	while( seg_idx < seg_num )
-	{
-		mLineStartList.push_back(line_info(seg_idx,seg_offset));
-		BOOL line_ended = FALSE;
-		S32 start_x = mShowLineNumbers ? UI_TEXTEDITOR_LINE_NUMBER_MARGIN : 0;
-		S32 line_width = start_x;
-		while(!line_ended && seg_idx < seg_num)
-		{
-			LLTextSegment* segment = mSegments[seg_idx];
-			S32 start_idx = segment->getStart() + seg_offset;
-			S32 end_idx = start_idx;
-			while (end_idx < segment->getEnd() && mWText[end_idx] != '\n')
-			{
-				end_idx++;
-			}
-			if (start_idx == end_idx)
+
+		S32 seg_num = mSegments.size();
+		S32 seg_idx = 0;
+		S32 seg_offset = 0;
+		getSegmentAndOffset(startpos, &seg_idx, &seg_offset);
+
+		while( seg_idx < seg_num )
+		{
+			S32 line_start = mSegments[seg_idx]->getStart() + seg_offset;
+			if (line_start >= mLayoutDamage.mEnd)
 			{
-				if (end_idx >= segment->getEnd())
-				{
-					// empty segment
-					seg_idx++;
-					seg_offset = 0;
-				}
-				else
+				// A line depends only on the text from its start on, so once
+				// past the changes, meeting a line start of the old layout
+				// means the rest of that layout still holds.
+				S32 old_start = line_start - mLayoutDamage.mDelta;
+				line_list_t::iterator old_iter = std::lower_bound(old_lines.begin(), old_lines.end(), old_start);
+				if (old_iter != old_lines.end() && *old_iter == old_start)
 				{
-					// empty line
-					line_ended = TRUE;
-					seg_offset++;
+					for ( ; old_iter != old_lines.end(); ++old_iter)
+					{
+						mLineStartList.push_back(*old_iter + mLayoutDamage.mDelta);
+					}
+					break;
 				}
 			}
-			else
-			{ 
-				const llwchar* str = mWText.c_str() + start_idx;
-				S32 drawn = mGLFont->maxDrawableChars(str, (F32)abs(mTextRect.getWidth()) - line_width,
-													  end_idx - start_idx, mWordWrap ? LLFontGL::WORD_BOUNDARY_IF_POSSIBLE : LLFontGL::ANYWHERE, mAllowEmbeddedItems );
-				if( 0 == drawn && line_width == start_x)
+			mLineStartList.push_back(line_start);
+			BOOL line_ended = FALSE;
+			S32 start_x = mShowLineNumbers ? UI_TEXTEDITOR_LINE_NUMBER_MARGIN : 0;
+			S32 line_width = start_x;
+			while(!line_ended && seg_idx < seg_num)
+			{
+				LLTextSegment* segment = mSegments[seg_idx];
+				S32 start_idx = segment->getStart() + seg_offset;
+				S32 end_idx = start_idx;
+				while (end_idx < segment->getEnd() && mWText[end_idx] != '\n')
 				{
-					// If at the beginning of a line, draw at least one character, even if it doesn't all fit.
-					drawn = 1;
+					end_idx++;
 				}
-				seg_offset += drawn;
-				line_width += mGLFont->getWidth(str, 0, drawn, mAllowEmbeddedItems);
-				end_idx = segment->getStart() + seg_offset;
-				if (end_idx < segment->getEnd())
+				if (start_idx == end_idx)
 				{
-					line_ended = TRUE;
-					if (mWText[end_idx] == '\n')
+					if (end_idx >= segment->getEnd())
 					{
-						seg_offset++; // skip newline
+						// empty segment
+						seg_idx++;
+						seg_offset = 0;
+					}
+					else
+					{
+						// empty line
+						line_ended = TRUE;
+						seg_offset++;
 					}
 				}
 				else
-				{
-					// finished with segment
-					seg_idx++;
-					seg_offset = 0;
+				{ 
+					const llwchar* str = mWText.c_str() + start_idx;
+					S32 drawn = mGLFont->maxDrawableChars(str, (F32)abs(mTextRect.getWidth()) - line_width,
+														  end_idx - start_idx, mWordWrap ? LLFontGL::WORD_BOUNDARY_IF_POSSIBLE : LLFontGL::ANYWHERE, mAllowEmbeddedItems );
+					if( 0 == drawn && line_width == start_x)
+					{
+						// If at the beginning of a line, draw at least one character, even if it doesn't all fit.
+						drawn = 1;
+					}
+					seg_offset += drawn;
+					line_width += mGLFont->getWidth(str, 0, drawn, mAllowEmbeddedItems);
+					end_idx = segment->getStart() + seg_offset;
+					if (end_idx < segment->getEnd())
+					{
+						line_ended = TRUE;
+						if (mWText[end_idx] == '\n')
+						{
+							seg_offset++; // skip newline
+						}
+					}
+					else
+					{
+						// finished with segment
+						seg_idx++;
+						seg_offset = 0;
+					}
 				}
 			}
 		}
-	}
 	
-	unbindEmbeddedChars(mGLFont);
+		unbindEmbeddedChars(mGLFont);
+		mLayoutDamage.setNone();
+	}
 
 	mScrollbar->setDocSize( getLineCount() );
 
@@ -620,6 +659,7 @@ BOOL LLTextEditor::truncate()
 			temp_utf8_text = utf8str_truncate( temp_utf8_text, mMaxTextByteLength );
 			mWText = utf8str_to_wstring( temp_utf8_text );
 			mTextIsUpToDate = FALSE;
+			noteTextReplaced();
 			did_truncate = TRUE;
 		}
 	}
@@ -634,6 +674,7 @@ void LLTextEditor::setText(const LLStringExplicit &utf8str)
 	// mUTF8Text = utf8str;
 	mWText = utf8str_to_wstring(mUTF8Text);
 	mTextIsUpToDate = TRUE;
+	noteTextReplaced();
 
 	truncate();
 	blockUndo();
@@ -651,6 +692,7 @@ void LLTextEditor::setWText(const LLWString &wtext)
 	mWText = wtext;
 	mUTF8Text.clear();
 	mTextIsUpToDate = FALSE;
+	noteTextReplaced();
 
 	truncate();
 	blockUndo();
@@ -692,6 +734,7 @@ LLSD LLTextEditor::getValue() const
 void LLTextEditor::setWordWrap(BOOL b)
 {
 	mWordWrap = b; 
+	mLayoutDamage.setAll();
 
 	setCursorPos(0);
 	deselect();
@@ -884,17 +927,14 @@ S32 LLTextEditor::getLineStart( S32 line ) const
     }
 
 	line = llclamp(line, 0, num_lines-1);
-	S32 segidx = mLineStartList[line].mSegment;
-	S32 segoffset = mLineStartList[line].mOffset;
-	LLTextSegment* seg = mSegments[segidx];
-	S32 res = seg->getStart() + segoffset;
-	if (res > seg->getEnd()) 
+	S32 res = mLineStartList[line];
+	if (res > getLength()) 
 	{
 		//llerrs << "wtf" << llendl;
 		// This happens when creating a new notecard using the AO on certain opensims.
 		// Play it safe instead of bringing down the viewer - MC
-		llwarns << "BAD JOOJOO! Text length (" << res << ") greater than text end (" << seg->getEnd() << "). Setting line start to " << seg->getEnd() << llendl;
-		res = seg->getEnd();
+		llwarns << "BAD JOOJOO! Text length (" << res << ") greater than text end (" << getLength() << "). Setting line start to " << getLength() << llendl;
+		res = getLength();
 	}
 	return res;
 }
@@ -909,15 +949,10 @@ void LLTextEditor::getLineAndOffset( S32 startpos, S32* linep, S32* offsetp ) co
 	}
 	else
 	{
-		S32 seg_idx, seg_offset;
-		getSegmentAndOffset( startpos, &seg_idx, &seg_offset );
-
-		line_info tline(seg_idx, seg_offset);
-		line_list_t::const_iterator iter = std::upper_bound(mLineStartList.begin(), mLineStartList.end(), tline, line_info_compare());
+		line_list_t::const_iterator iter = std::upper_bound(mLineStartList.begin(), mLineStartList.end(), startpos);
 		if (iter != mLineStartList.begin()) --iter;
 		*linep = iter - mLineStartList.begin();
-		S32 line_start = mSegments[iter->mSegment]->getStart() + iter->mOffset;
-		*offsetp = startpos - line_start;
+		*offsetp = startpos - *iter;
 	}
 }
 
@@ -3632,7 +3667,7 @@ void LLTextEditor::draw()
 	// do on-demand reflow 
 	if (mReflowNeeded)
 	{
-		updateLineStartList();
+		reflow();
 		mReflowNeeded = FALSE;
 	}
 
@@ -4258,8 +4293,7 @@ void LLTextEditor::removeTextFromEnd(S32 num_chars)
 
 	pruneSegments();
 	
-	// pruneSegments will invalidate mLineStartList.
-	updateLineStartList();
+	reflow();
 	needsScroll();
 }
 
@@ -4273,6 +4307,7 @@ S32 LLTextEditor::insertStringNoUndo(const S32 pos, const LLWString &wstr)
 
 	mWText.insert(pos, wstr);
 	mTextIsUpToDate = FALSE;
+	noteTextChange(pos, 0, insert_len);
 
 	if ( truncate() )
 	{
@@ -4288,6 +4323,7 @@ S32 LLTextEditor::removeStringNoUndo(S32 pos, S32 length)
 {
 	mWText.erase(pos, length);
 	mTextIsUpToDate = FALSE;
+	noteTextChange(pos, length, 0);
 	return -length;	// This will be wrong if someone calls removeStringNoUndo with an excessive length
 }
 
@@ -4299,9 +4335,62 @@ S32 LLTextEditor::overwriteCharNoUndo(S32 pos, llwchar wc)
 	}
 	mWText[pos] = wc;
 	mTextIsUpToDate = FALSE;
+	noteTextChange(pos, 1, 1);
 	return 1;
 }
 
+void LLTextEditor::noteTextChange(S32 pos, S32 removed, S32 inserted)
+{
+	mHighlightDamage.add(pos, removed, inserted);
+	mLayoutDamage.add(pos, removed, inserted);
+}
+
+void LLTextEditor::noteTextReplaced()
+{
+	mHighlightDamage.setAll();
+	mLayoutDamage.setAll();
+}
+
+void LLTextEditor::damage_range::add(S32 pos, S32 removed, S32 inserted)
+{
+	S32 change = inserted - removed;
+	if (isEmpty())
+	{
+		mStart = pos;
+		mEnd = pos + inserted;
+		mDelta = change;
+		return;
+	}
+	mStart = llmin(mStart, pos);
+	if (mEnd == S32_MAX)
+	{
+		// Everything after mStart is suspect anyway.
+		return;
+	}
+	if (mEnd >= pos + removed)
+	{
+		mEnd += change;
+	}
+	else
+	{
+		mEnd = pos + inserted;
+	}
+	mDelta += change;
+}
+
+void LLTextEditor::damage_range::include(S32 start, S32 end)
+{
+	if (isEmpty())
+	{
+		mDelta = 0;
+		mStart = start;
+		mEnd = end;
+		return;
+	}
+	mStart = llmin(mStart, start);
+	mEnd = llmax(mEnd, end);
+}
+
 //----------------------------------------------------------------------------
 
 void LLTextEditor::makePristine()
@@ -4389,6 +4478,8 @@ void LLTextEditor::loadKeywords(const std::string& filename,
 		}
 		segment_list_t segment_list;
 		mKeywords.findSegments(&segment_list, getWText(), mDefaultColor);
+		mHighlightDamage.setNone();
+		mLayoutDamage.setAll();
 
 		mSegments.clear();
 		segment_list_t::iterator insert_it = mSegments.begin();
@@ -4408,13 +4499,20 @@ void LLTextEditor::updateSegments()
 		LLFastTimer ft(FTM_SYNTAX_HIGHLIGHTING);
 		if (mKeywords.isLoaded())
 		{
-			// HACK:  No non-ascii keywords for now
-			mKeywords.findSegments(&mSegments, mWText, mDefaultColor);
+			if (!mHighlightDamage.isEmpty())
+			{
+				// HACK:  No non-ascii keywords for now
+				S32 resync_pos = mKeywords.updateSegments(&mSegments, mWText, mDefaultColor,
+														  mHighlightDamage.mStart, mHighlightDamage.mEnd, mHighlightDamage.mDelta);
+				// Segments up to where the old ones were picked up again may have moved.
+				mLayoutDamage.include(mHighlightDamage.mStart, resync_pos);
+			}
 		}
 		else if (mAllowEmbeddedItems)
 		{
 			findEmbeddedItemSegments();
 		}
+		mHighlightDamage.setNone();
 	}
 
 	LLFastTimer ft(FTM_UPDATE_TEXT_SEGMENTS);
@@ -4433,7 +4531,6 @@ void LLTextEditor::updateSegments()
 }
 
 // Only effective if text was removed from the end of the editor
-// *NOTE: Using this will invalidate references to mSegments from mLineStartList.
 void LLTextEditor::pruneSegments()
 {
 	S32 len = mWText.length();
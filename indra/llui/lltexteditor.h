@@ -485,6 +485,9 @@ private:
 
 	void			updateSegments();
 	void			pruneSegments();
+	void			reflow();
+	void			noteTextChange(S32 pos, S32 removed, S32 inserted);
+	void			noteTextReplaced();
 
 	void			drawBackground();
 	void			drawSelectionBackground();
@@ -539,26 +542,23 @@ private:
 
 	S32				mDesiredXPixel;			// X pixel position where the user wants the cursor to be
 	LLRect			mTextRect;				// The rect in which text is drawn.  Excludes borders.
-	// List of offsets and segment index of the start of each line.  Always has at least one node (0).
-	struct line_info
-	{
-		line_info(S32 segment, S32 offset) : mSegment(segment), mOffset(offset) {}
-		S32 mSegment;
-		S32 mOffset;
-	};
-	struct line_info_compare
+	// Offset of the start of each line.  Always has at least one node (0).
+	typedef std::vector<S32> line_list_t;
+
+	// Part of mWText changed since some earlier state of it, in current offsets.
+	// The text from mEnd on is the earlier text from mEnd - mDelta on.
+	struct damage_range
 	{
-		bool operator()(const line_info& a, const line_info& b) const
-		{
-			if (a.mSegment < b.mSegment)
-				return true;
-			else if (a.mSegment > b.mSegment)
-				return false;
-			else
-				return a.mOffset < b.mOffset;
-		}
+		damage_range() { setAll(); }
+		void setAll() { mStart = 0; mEnd = S32_MAX; mDelta = 0; }
+		void setNone() { mStart = S32_MAX; mEnd = 0; mDelta = 0; }
+		bool isEmpty() const { return mStart > mEnd; }
+		void add(S32 pos, S32 removed, S32 inserted);
+		void include(S32 start, S32 end);
+		S32 mStart;
+		S32 mEnd;
+		S32 mDelta;
 	};
-	typedef std::vector<line_info> line_list_t;
 
 	//to keep track of what we have to remove before showing menu
 	std::vector<SpellMenuBind* > suggestionMenuItems;
@@ -568,6 +568,9 @@ private:
 	line_list_t mLineStartList;
 	BOOL			mReflowNeeded;
 	BOOL			mScrollNeeded;
+	damage_range	mHighlightDamage;		// Text changed since the last updateSegments()
+	damage_range	mLayoutDamage;			// Text and segments changed since the last reflow()
+	S32				mLayoutWidth;			// mTextRect width mLineStartList was wrapped for
 
 	LLFrameTimer	mKeystrokeTimer;
 	LLFrameTimer	mSpellTimer;
@@ -619,6 +622,7 @@ public:
 
 	S32					getStart() const					{ return mStart; }
 	S32					getEnd() const						{ return mEnd; }
+	void				setStart( S32 start )				{ mStart = start; }
 	void				setEnd( S32 end )					{ mEnd = end; }
 	const LLColor4&		getColor() const					{ return mStyle->getColor(); }
 	void 				setColor(const LLColor4 &color)		{ mStyle->setColor(color); }
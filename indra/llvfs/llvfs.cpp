@@ -39,6 +39,8 @@
 #include <fcntl.h>
 #else
 #include <sys/file.h>
+#include <unistd.h>
+#include <errno.h>
 #endif
     
 #include "llstl.h"
@@ -214,7 +216,8 @@ const S32 LLVFSFileBlock::SERIAL_SIZE = 34;
 LLVFS::LLVFS(const std::string& index_filename, const std::string& data_filename, const BOOL read_only, const U32 presize, const BOOL remove_after_crash)
 :	mRemoveAfterCrash(remove_after_crash),
 	mDataFP(NULL),
-	mIndexFP(NULL)
+	mIndexFP(NULL),
+	mIndexEnd(-1)
 {
 	mDataMutex = new LLMutex;
 
@@ -627,7 +630,9 @@ void LLVFS::presizeDataFile(const U32 size)
 	fseek(mDataFP, size-1, SEEK_SET);
 	S32 tmp = 0;
 	tmp = (S32)fwrite(&tmp, 1, 1, mDataFP);
-	// fflush(mDataFP);
+	// Data is otherwise written with positional I/O, don't leave this
+	// byte sitting in the stdio buffer.
+	fflush(mDataFP);
 
 	// also remove any index, since this vfs is now blank
 	LLFile::remove(mIndexFilename);
@@ -854,11 +859,9 @@ BOOL LLVFS::setMaxSize(const LLUUID &file_id, const LLAssetType::EType file_type
 					{
 						// move the file into the new block
 						std::vector<U8> buffer(block->mSize);
-						fseek(mDataFP, block->mLocation, SEEK_SET);
-						if (fread(&buffer[0], block->mSize, 1, mDataFP) == 1)
+						if (readDataAt(&buffer[0], block->mLocation, block->mSize) == block->mSize)
 						{
-							fseek(mDataFP, new_data_location, SEEK_SET);
-							if (fwrite(&buffer[0], block->mSize, 1, mDataFP) != 1)
+							if (writeDataAt(&buffer[0], new_data_location, block->mSize) != block->mSize)
 							{
 								llwarns << "Short write" << llendl;
 							}
@@ -1088,8 +1091,7 @@ S32 LLVFS::getData(const LLUUID &file_id, const LLAssetType::EType file_type, U8
 
 	if (do_read)
 	{
-		fseek(mDataFP, location, SEEK_SET);
-		bytesread = (S32)fread(buffer, 1, length, mDataFP);
+		bytesread = readDataAt(buffer, location, length);
 	}
 	
 	unlockData();
@@ -1158,8 +1160,7 @@ S32 LLVFS::storeData(const LLUUID &file_id, const LLAssetType::EType file_type,
 			}
 			U32 file_location = location + block->mLocation;
 			
-			fseek(mDataFP, file_location, SEEK_SET);
-			S32 write_len = (S32)fwrite(buffer, 1, length, mDataFP);
+			S32 write_len = writeDataAt(buffer, file_location, length);
 			if (write_len != length)
 			{
 				llwarns << llformat("VFS Write Error: %d != %d",write_len,length) << llendl;
@@ -1475,10 +1476,13 @@ void LLVFS::sync(LLVFSFileBlock *block, BOOL remove)
 
     if (set_index_to_end)
 	{
-		// Need fseek/ftell to update the seek_pos and hence data
-		// structures, so can't unlockData() before this.
-		fseek(mIndexFP, 0, SEEK_END);
-		seek_pos = ftell(mIndexFP);
+		if (mIndexEnd < 0)
+		{
+			fseek(mIndexFP, 0, SEEK_END);
+			mIndexEnd = ftell(mIndexFP);
+		}
+		seek_pos = mIndexEnd;
+		mIndexEnd += LLVFSFileBlock::SERIAL_SIZE;
 	}
 	    
 	block->mIndexLocation = seek_pos;
@@ -1487,32 +1491,106 @@ void LLVFS::sync(LLVFSFileBlock *block, BOOL remove)
 		mIndexHoles.push_back(seek_pos);
 	}
 
-	U8 buffer[LLVFSFileBlock::SERIAL_SIZE];
+	// Queue the record; unlockData() writes it out along with any others
+	// synced under the same lock.
+	std::vector<U8>& buffer = mPendingIndexWrites[seek_pos];
+	buffer.resize(LLVFSFileBlock::SERIAL_SIZE);
 	if (remove)
 	{
-		memset(buffer, 0, LLVFSFileBlock::SERIAL_SIZE);
+		memset(&buffer[0], 0, LLVFSFileBlock::SERIAL_SIZE);
 	}
 	else
 	{
-		block->serialize(buffer);
+		block->serialize(&buffer[0]);
 	}
+}
 
-	// If set_index_to_end, file pointer is already at seek_pos
-	// and we don't need to do anything.  Only seek if not at end.
-	if (!set_index_to_end)
+// mDataMutex must be LOCKED before calling this
+// Writes the queued index records in file order, one fwrite per run of
+// adjacent records.
+void LLVFS::flushIndexWrites()
+{
+	std::vector<U8> run;
+	long run_start = 0;
+	for (index_write_map_t::iterator iter = mPendingIndexWrites.begin();
+		 iter != mPendingIndexWrites.end(); ++iter)
+	{
+		if (!run.empty() && iter->first != run_start + (long)run.size())
+		{
+			fseek(mIndexFP, run_start, SEEK_SET);
+			if (fwrite(&run[0], run.size(), 1, mIndexFP) != 1)
+			{
+				llwarns << "Short write" << llendl;
+			}
+			run.clear();
+		}
+		if (run.empty())
+		{
+			run_start = iter->first;
+		}
+		run.insert(run.end(), iter->second.begin(), iter->second.end());
+	}
+	if (!run.empty())
 	{
-		fseek(mIndexFP, seek_pos, SEEK_SET);
+		fseek(mIndexFP, run_start, SEEK_SET);
+		if (fwrite(&run[0], run.size(), 1, mIndexFP) != 1)
+		{
+			llwarns << "Short write" << llendl;
+		}
 	}
+	mPendingIndexWrites.clear();
+}
 
-	if (fwrite(buffer, LLVFSFileBlock::SERIAL_SIZE, 1, mIndexFP) != 1)
+// mDataMutex must be LOCKED before calling these
+S32 LLVFS::readDataAt(U8 *buffer, U32 location, S32 length)
+{
+#if LL_WINDOWS
+	fseek(mDataFP, location, SEEK_SET);
+	return (S32)fread(buffer, 1, length, mDataFP);
+#else
+	// pread doesn't move the file offset or go through the stdio buffer.
+	int fd = fileno(mDataFP);
+	S32 total = 0;
+	while (total < length)
 	{
-		llwarns << "Short write" << llendl;
+		ssize_t n = pread(fd, buffer + total, length - total, (off_t)location + total);
+		if (n < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		if (n <= 0)
+		{
+			break;
+		}
+		total += (S32)n;
 	}
+	return total;
+#endif
+}
 
-	// *NOTE:  Why was this commented out?
-	// fflush(mIndexFP);
-	
-	return;
+S32 LLVFS::writeDataAt(const U8 *buffer, U32 location, S32 length)
+{
+#if LL_WINDOWS
+	fseek(mDataFP, location, SEEK_SET);
+	return (S32)fwrite(buffer, 1, length, mDataFP);
+#else
+	int fd = fileno(mDataFP);
+	S32 total = 0;
+	while (total < length)
+	{
+		ssize_t n = pwrite(fd, buffer + total, length - total, (off_t)location + total);
+		if (n < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		if (n <= 0)
+		{
+			break;
+		}
+		total += (S32)n;
+	}
+	return total;
+#endif
 }
 
 // mDataMutex must be LOCKED before calling this
@@ -1600,7 +1678,7 @@ LLVFSBlock *LLVFS::findFreeBlock(S32 size, LLVFSFileBlock *immune)
 			{
 				file_block = *it;
 				
-				// TODO: it would be great to be able to batch all these sync() calls
+				// The sync() calls made here are committed as one batch by unlockData().
 				// llinfos << "LRU2: Removing " << file_block->mFileID << ":" << file_block->mFileType << " last accessed" << file_block->mAccessTime << llendl;
 
 				cleaned_up += file_block->mLength;
@@ -1685,6 +1763,7 @@ void LLVFS::audit()
 	// Lock the mutex through this whole function.
 	LLMutexLock lock_data(mDataMutex);
 	
+	flushIndexWrites();
 	fflush(mIndexFP);
 
 	fseek(mIndexFP, 0, SEEK_END);
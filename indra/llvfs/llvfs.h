@@ -28,6 +28,8 @@
 #define LL_LLVFS_H
 
 #include <deque>
+#include <map>
+#include <vector>
 #include "lluuid.h"
 #include "linked_lists.h"
 #include "llassettype.h"
@@ -188,9 +190,16 @@ protected:
 	// The immune file block will not be removed.
 	LLVFSBlock *findFreeBlock(S32 size, LLVFSFileBlock *immune = NULL);
 
+	// Positional I/O on the data file; mDataMutex must be LOCKED.
+	S32 readDataAt(U8 *buffer, U32 location, S32 length);
+	S32 writeDataAt(const U8 *buffer, U32 location, S32 length);
+
+	// Write out the index records queued by sync().
+	void flushIndexWrites();
+
 	// lock/unlock data mutex (mDataMutex)
 	void lockData() { mDataMutex->lock(); }
-	void unlockData() { mDataMutex->unlock(); }	
+	void unlockData() { if (!mPendingIndexWrites.empty()) flushIndexWrites(); mDataMutex->unlock(); }	
 	
 protected:
 	LLMutex* mDataMutex;
@@ -213,6 +222,13 @@ protected:
 
 	std::deque<S32> mIndexHoles;
 
+	// Index records written by sync() while the data mutex is held, keyed
+	// by their offset in the index file. They are committed together, in
+	// file order, when the mutex is released.
+	typedef std::map<long, std::vector<U8> > index_write_map_t;
+	index_write_map_t mPendingIndexWrites;
+	long mIndexEnd;		// logical end of the index file, -1 if not known yet
+
 	std::string mIndexFilename;
 	std::string mDataFilename;
 	BOOL mReadOnly;
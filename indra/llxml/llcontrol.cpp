@@ -1488,6 +1488,56 @@ LLSD convert_from_llsd<LLSD>(const LLSD& sd, eControlType type, const std::strin
 }
 
 
+//============================================================================
+// LLAtomicControlBase
+
+LLAtomicControlBase* LLAtomicControlBase::sHead;
+bool LLAtomicControlBase::sBound;
+
+LLAtomicControlBase::LLAtomicControlBase(LLControlGroup& group, const char* name, const char* comment)
+:	mGroup(group),
+	mName(name),
+	mComment(comment),
+	mNext(NULL)
+{
+}
+
+LLAtomicControlBase::~LLAtomicControlBase()
+{
+	for (LLAtomicControlBase** slot = &sHead; *slot; slot = &(*slot)->mNext)
+	{
+		if (*slot == this)
+		{
+			*slot = mNext;
+			break;
+		}
+	}
+}
+
+void LLAtomicControlBase::registerSlot()
+{
+	mNext = sHead;
+	sHead = this;
+	if (sBound)
+	{
+		bind();
+	}
+}
+
+//static
+void LLAtomicControlBase::bindAll()
+{
+	if (sBound)
+	{
+		return;
+	}
+	sBound = true;
+	for (LLAtomicControlBase* slot = sHead; slot; slot = slot->mNext)
+	{
+		slot->bind();
+	}
+}
+
 #if TEST_CACHED_CONTROL
 
 #define DECL_LLCC(T, V) static LLCachedControl<T> mySetting_##T("TestCachedControl"#T, V)
@@ -37,6 +37,7 @@
 #include "v4coloru.h"
 #include "llinstancetracker.h"
 #include "llrefcount.h"
+#include "llatomic.h"
 
 #include "llcontrolgroupreader.h"
 
@@ -523,6 +524,120 @@ private:
 	LLPointer<LLControlCache<T> > mCachedControlPtr;
 };
 
+//! Thread safe, typed view of a BOOL, S32, U32 or F32 control.
+
+//! LLCachedControl returns a reference to a value that is overwritten
+//! whenever the control changes, and binding one to its control goes through
+//! the string keyed lookups of LLControlGroup and LLInstanceTracker; neither
+//! is safe away from the main thread. An LLAtomicControl keeps the value in
+//! an atomic word instead, so reading it is a plain load from any thread.
+//!
+//! Declare them at file scope. They are bound to their controls on the main
+//! thread by LLAtomicControlBase::bindAll() once the settings are loaded,
+//! and read their default value until then.
+class LLAtomicControlBase
+{
+public:
+	// Binds every slot constructed so far; slots constructed later are bound
+	// right away. Main thread only.
+	static void bindAll();
+
+protected:
+	LLAtomicControlBase(LLControlGroup& group, const char* name, const char* comment);
+	virtual ~LLAtomicControlBase();
+
+	// Adds the slot to the list bindAll() walks. Call from the constructor
+	// of the derived class, so that bind() can be called.
+	void registerSlot();
+
+	// Declares the control if needed and starts tracking its value.
+	virtual void bind() = 0;
+
+	LLControlGroup& mGroup;
+	const char* mName;
+	const char* mComment;
+	boost::signals2::scoped_connection mConnection;
+
+private:
+	LLAtomicControlBase* mNext;
+	static LLAtomicControlBase* sHead;	// Zero initialized, so construction order doesn't matter.
+	static bool sBound;
+};
+
+// Conversion between a control value and the word an LLAtomicControl stores.
+// Only the 32 bit scalar types have one.
+template <typename T> struct LLAtomicControlWord;
+
+template <> struct LLAtomicControlWord<bool>
+{
+	static U32 pack(bool value) { return value ? 1 : 0; }
+	static bool unpack(U32 word) { return word != 0; }
+};
+
+template <> struct LLAtomicControlWord<S32>
+{
+	static U32 pack(S32 value) { return (U32)value; }
+	static S32 unpack(U32 word) { return (S32)word; }
+};
+
+template <> struct LLAtomicControlWord<U32>
+{
+	static U32 pack(U32 value) { return value; }
+	static U32 unpack(U32 word) { return word; }
+};
+
+template <> struct LLAtomicControlWord<F32>
+{
+	static U32 pack(F32 value) { U32 word; memcpy(&word, &value, sizeof(word)); return word; }
+	static F32 unpack(U32 word) { F32 value; memcpy(&value, &word, sizeof(value)); return value; }
+};
+
+template <typename T>
+class LLAtomicControl : public LLAtomicControlBase
+{
+public:
+	LLAtomicControl(LLControlGroup& group,
+					const char* name,
+					const T& default_value,
+					const char* comment = "Declared In Code")
+	:	LLAtomicControlBase(group, name, comment),
+		mDefault(default_value),
+		mWord(LLAtomicControlWord<T>::pack(default_value))
+	{
+		registerSlot();
+	}
+
+	operator T() const { return get(); }
+	T get() const { return LLAtomicControlWord<T>::unpack(mWord); }
+
+private:
+	/*virtual*/ void bind()
+	{
+		if (!mGroup.controlExists(mName))
+		{
+			mGroup.declareControl(mName, get_control_type<T>(), convert_to_llsd(mDefault), mComment, FALSE);
+		}
+		LLControlVariablePtr controlp = mGroup.getControl(mName);
+		mType = controlp->type();
+		handleValueChange(controlp->get());
+		mConnection = controlp->getSignal()->connect(
+			boost::bind(&LLAtomicControl<T>::handleValueChange, this, _2),
+			boost::signals2::at_front);
+		mControl = controlp;
+	}
+
+	bool handleValueChange(const LLSD& newvalue)
+	{
+		mWord = LLAtomicControlWord<T>::pack(convert_from_llsd<T>(newvalue, mType, mName));
+		return true;
+	}
+
+	T mDefault;
+	LLAtomicU32 mWord;
+	LLPointer<LLControlVariable> mControl;
+	eControlType mType;
+};
+
 template <> eControlType get_control_type<U32>();
 template <> eControlType get_control_type<S32>();
 template <> eControlType get_control_type<F32>();
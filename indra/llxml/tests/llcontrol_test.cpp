@@ -0,0 +1,119 @@
+/**
+ * @file llcontrol_test.cpp
+ * @brief Checks LLAtomicControl and compares the cost of the ways to read a setting.
+ *
+ * $LicenseInfo:firstyear=2013&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+#include "lltimer.h"
+// Class to test
+#include "../llcontrol.h"
+// Tut header
+#include "../test/lltut.h"
+
+// The viewer defines gSavedSettings; LLCachedControl uses it.
+LLControlGroup gSavedSettings("Global");
+
+// Declared at file scope, like the atomic controls of the viewer.
+static LLAtomicControl<S32> sAtomicS32(gSavedSettings, "TestAtomicControlS32", -666);
+static LLAtomicControl<U32> sAtomicU32(gSavedSettings, "TestAtomicControlU32", 666);
+static LLAtomicControl<F32> sAtomicF32(gSavedSettings, "TestAtomicControlF32", -666.666f);
+static LLAtomicControl<bool> sAtomicBool(gSavedSettings, "TestAtomicControlbool", true);
+
+namespace tut
+{
+	struct control_test
+	{
+	};
+	typedef test_group<control_test> control_t;
+	typedef control_t::object control_object_t;
+	tut::control_t tut_control("LLControl");
+
+	// Slots read their default until bound, then follow their control.
+	template<> template<>
+	void control_object_t::test<1>()
+	{
+		ensure_equals("S32 default", (S32)sAtomicS32, -666);
+		ensure_equals("U32 default", (U32)sAtomicU32, (U32)666);
+		ensure_equals("F32 default", (F32)sAtomicF32, -666.666f);
+		ensure_equals("bool default", (bool)sAtomicBool, true);
+		ensure("not declared before binding", !gSavedSettings.controlExists("TestAtomicControlS32"));
+
+		LLAtomicControlBase::bindAll();
+		ensure("declared by binding", gSavedSettings.controlExists("TestAtomicControlS32"));
+		ensure_equals("declared with the default", gSavedSettings.getS32("TestAtomicControlS32"), -666);
+
+		gSavedSettings.setS32("TestAtomicControlS32", -42);
+		gSavedSettings.setU32("TestAtomicControlU32", 42);
+		gSavedSettings.setF32("TestAtomicControlF32", 4.2f);
+		gSavedSettings.setBOOL("TestAtomicControlbool", FALSE);
+		ensure_equals("S32 set", (S32)sAtomicS32, -42);
+		ensure_equals("U32 set", (U32)sAtomicU32, (U32)42);
+		ensure_equals("F32 set", (F32)sAtomicF32, 4.2f);
+		ensure_equals("bool set", (bool)sAtomicBool, false);
+	}
+
+	// A slot constructed after bindAll() is bound right away, to an existing control if there is one.
+	template<> template<>
+	void control_object_t::test<2>()
+	{
+		LLAtomicControlBase::bindAll();
+		gSavedSettings.declareS32("TestAtomicControlLate", 7, "Declared before the slot", FALSE);
+		{
+			LLAtomicControl<S32> late(gSavedSettings, "TestAtomicControlLate", 3);
+			ensure_equals("existing value", (S32)late, 7);
+			gSavedSettings.setS32("TestAtomicControlLate", 8);
+			ensure_equals("set", (S32)late, 8);
+		}
+		// The slot disconnected itself, so this doesn't write to it.
+		gSavedSettings.setS32("TestAtomicControlLate", 9);
+	}
+
+	// Per lookup cost of the three ways to read a setting. Only reported, since it depends on the machine.
+	template<> template<>
+	void control_object_t::test<3>()
+	{
+		LLAtomicControlBase::bindAll();
+		static LLCachedControl<S32> cached("TestAtomicControlS32", 0);
+
+		const S32 LOOKUPS = 1000000;
+		S64 sum = 0;
+		LLTimer timer;
+		for (S32 i = 0; i < LOOKUPS; ++i)
+		{
+			sum += gSavedSettings.getS32("TestAtomicControlS32");
+		}
+		F64 string_time = timer.getElapsedTimeAndResetF64();
+		for (S32 i = 0; i < LOOKUPS; ++i)
+		{
+			sum += (S32)cached;
+		}
+		F64 cached_time = timer.getElapsedTimeAndResetF64();
+		for (S32 i = 0; i < LOOKUPS; ++i)
+		{
+			sum += (S32)sAtomicS32;
+		}
+		F64 atomic_time = timer.getElapsedTimeF64();
+		ensure_equals("all lookups read the same value", sum, (S64)3 * LOOKUPS * gSavedSettings.getS32("TestAtomicControlS32"));
+		llinfos << "Control lookups (ns): getS32 " << string_time * 1.0e9 / LOOKUPS
+				<< ", LLCachedControl " << cached_time * 1.0e9 / LOOKUPS
+				<< ", LLAtomicControl " << atomic_time * 1.0e9 / LOOKUPS << llendl;
+	}
+}
@@ -67,6 +67,7 @@ class AIServiceBar : public LLView
 
 int const mc_col = number_of_capability_types;				// Maximum connections column.
 int const bw_col = number_of_capability_types + 1;			// Bandwidth column.
+int const tm_col = number_of_capability_types + 2;			// Timings column.
 
 void AIServiceBar::draw()
 {
@@ -84,6 +85,10 @@ void AIServiceBar::draw()
   int established_connections;
   int concurrent_connections;
   size_t bandwidth;
+  U32 finished;
+  U32 reused_connections;
+  U32 wait_time;
+  U32 transfer_time;
   {
 	PerService_rat per_service_r(*mPerService);
 	is_used = per_service_r->is_used();
@@ -94,6 +99,10 @@ void AIServiceBar::draw()
 	concurrent_connections = per_service_r->mConcurrentConnections;
 	bandwidth = per_service_r->bandwidth().truncateData(AIHTTPView::getTime_40ms());
 	cts = per_service_r->mCapabilityType;	// Not thread-safe, but we're only reading from it and only using the results to show in a debug console.
+	finished = per_service_r->mConsoleNewConnections + per_service_r->mConsoleReusedConnections;
+	reused_connections = per_service_r->mConsoleReusedConnections;
+	wait_time = per_service_r->mConsoleWaitTimes.percentile(0.5);
+	transfer_time = per_service_r->mConsoleTransferTimes.percentile(0.5);
   }
   for (int col = 0; col < number_of_capability_types; ++col)
   {
@@ -111,14 +120,14 @@ void AIServiceBar::draw()
 	  {
 		text = llformat(" | %hu-%hd-%lu,{%hu/%hu,%u}/%u",
 			ct.mApprovedRequests, ct.mQueuedCommands, ct.mQueuedRequests.size(),
-			ct.mAdded, ct.mConcurrentConnections, ct.mDownloading,
+			ct.mAdded, ct.connection_limit(), ct.mDownloading,
 			ct.mMaxPipelinedRequests);
 	  }
 	  else
 	  {
 		text = llformat(" | --%hd-%lu,{%hu/%hu,%u}",
 			ct.mQueuedCommands, ct.mQueuedRequests.size(),
-			ct.mAdded, ct.mConcurrentConnections, ct.mDownloading);
+			ct.mAdded, ct.connection_limit(), ct.mDownloading);
 	  }
 	  if (capability_type == cap_texture || capability_type == cap_mesh)
 	  {
@@ -171,6 +180,17 @@ void AIServiceBar::draw()
   start += LLFontGL::getFontMonospace()->getWidth(text);
   text = llformat("/%lu", max_bandwidth / 125);
   LLFontGL::getFontMonospace()->renderUTF8(text, 0, start, height, text_color, LLFontGL::LEFT, LLFontGL::TOP);
+  start += LLFontGL::getFontMonospace()->getWidth(text);
+  start = mHTTPView->updateColumn(tm_col, start);
+  if (finished)
+  {
+	text = llformat(" | %3u%% %u/%u", (reused_connections * 100 + finished / 2) / finished, wait_time, transfer_time);
+  }
+  else
+  {
+	text = " | -";
+  }
+  LLFontGL::getFontMonospace()->renderUTF8(text, 0, start, height, text_color, LLFontGL::LEFT, LLFontGL::TOP);
 }
 
 LLRect AIServiceBar::getRequiredRect(void)
@@ -223,6 +243,11 @@ void AIGLHTTPHeaderBar::draw(void)
   text = " | Tot/Max BW (kbit/s)";
   start = mHTTPView->updateColumn(bw_col, start);
   LLFontGL::getFontMonospace()->renderUTF8(text, 0, start, height, LLColor4::green, LLFontGL::LEFT, LLFontGL::TOP);
+  start += LLFontGL::getFontMonospace()->getWidth(text);
+  // Since the console was opened: connections reused, and the median server wait (request sent to first byte) and transfer time.
+  text = " | Reuse Wait/Transfer (ms)";
+  start = mHTTPView->updateColumn(tm_col, start);
+  LLFontGL::getFontMonospace()->renderUTF8(text, 0, start, height, LLColor4::green, LLFontGL::LEFT, LLFontGL::TOP);
   mHTTPView->setWidth(start + LLFontGL::getFontMonospace()->getWidth(text) + h_offset);
 
   // Second header line.
@@ -314,7 +339,10 @@ U32 AIHTTPView::updateColumn(U32 col, U32 start)
 void AIHTTPView::setVisible(BOOL visible)
 {
 	if (visible && visible != getVisible())
+	{
 		AIPerService::resetUsed();
+		AIPerService::resetAllConsoleStats();
+	}
 	LLContainerView::setVisible(visible);
 }
 
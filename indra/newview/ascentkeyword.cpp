@@ -34,7 +34,7 @@
 #include "ascentkeyword.h"
 #include "llviewercontrol.h"
 #include "llui.h"
-#include <boost/regex.hpp>
+#include "llahocorasick.h"
 
 
 BOOL AscentKeyword::hasKeyword(std::string msg,int source)
@@ -64,25 +64,43 @@ bool AscentKeyword::containsKeyWord(std::string source)
 	static const LLCachedControl<std::string> mKeywordsList(gSavedPerAccountSettings, "KeywordsList", "");
 	static const LLCachedControl<bool> mKeywordsPlaySound(gSavedPerAccountSettings, "KeywordsPlaySound", false);
 	static const LLCachedControl<std::string> mKeywordsSound(gSavedPerAccountSettings, "KeywordsSound", "");
+	// All keywords in one automaton, so a message is scanned once however
+	// many there are. Rebuilt only when the list changes.
+	static std::string sMatcherList;
+	static LLAhoCorasick<char> sMatcher;
 
-    std::string s = mKeywordsList;
+	std::string s = mKeywordsList;
 	LLStringUtil::toLower(s);
-	LLStringUtil::toLower(source);
-	boost::regex re(",");
-	boost::sregex_token_iterator i(s.begin(), s.end(), re, -1);
-	boost::sregex_token_iterator j;
-
-	while(i != j)
+	if (s != sMatcherList)
 	{
-		if(source.find( *i++) != std::string::npos)
+		sMatcher.clear();
+		size_t start = 0;
+		while (start <= s.size())
 		{
-			if (mKeywordsPlaySound)
-            {
-				LLUI::sAudioCallback(LLUUID(mKeywordsSound));
-            }
+			size_t end = s.find(',', start);
+			if (end == std::string::npos)
+			{
+				end = s.size();
+			}
+			if (end > start)
+			{
+				sMatcher.add(s.data() + start, end - start, 0);
+			}
+			start = end + 1;
+		}
+		sMatcher.compile();
+		sMatcherList = s;
+	}
 
-			return true;
+	LLStringUtil::toLower(source);
+	if (sMatcher.find(source.data(), source.data() + source.size()) >= 0)
+	{
+		if (mKeywordsPlaySound)
+		{
+			LLUI::sAudioCallback(LLUUID(mKeywordsSound));
 		}
+
+		return true;
 	}
 
     return false;
@@ -116,6 +116,7 @@
 #include "llnotify.h"
 #include "llviewerkeyboard.h"
 #include "lllfsthread.h"
+#include "lllogchat.h"
 #include "llworkerthread.h"
 #include "lltexturecache.h"
 #include "lltexturefetch.h"
@@ -309,6 +310,7 @@ const std::string LOG_FILE("Singularity.log");
 extern const std::string OLD_LOG_FILE("Singularity.old");
 static BOOL gDoDisconnect = FALSE;
 static std::string gLaunchFileOnQuit;
+static llofstream* gTimerLog = NULL;	// Per frame fast timer log, see StatsTimerLogFile
 
 // Used on Win32 for other apps to identify our window (eg, win_setup)
 const char* const VIEWER_WINDOW_CLASSNAME = "Second Life"; // Don't change
@@ -653,6 +655,27 @@ bool LLAppViewer::init()
 
 	LL_INFOS("InitInfo") << "Configuration initialized." << LL_ENDL ;
 
+	// Settings are loaded: let the thread safe controls track them.
+	LLAtomicControlBase::bindAll();
+
+	std::string timer_log = gSavedSettings.getString("StatsTimerLogFile");
+	if (!timer_log.empty())
+	{
+		std::string filename = gDirUtilp->getExpandedFilename(LL_PATH_LOGS, timer_log);
+		gTimerLog = new llofstream(filename);
+		if (gTimerLog->is_open())
+		{
+			llinfos << "Logging fast timer times to " << filename << llendl;
+			LLFastTimer::sLog = TRUE;
+		}
+		else
+		{
+			llwarns << "Unable to open " << filename << " for writing." << llendl;
+			delete gTimerLog;
+			gTimerLog = NULL;
+		}
+	}
+
 	//set the max heap size.
 	initMaxHeapSize() ;
 
@@ -782,6 +805,12 @@ bool LLAppViewer::init()
 	{
 		LLError::setPrintLocation(true);
 	}
+
+	if (gSavedSettings.getBOOL("AsyncLogging"))
+	{
+		U32 policy = llmin(gSavedSettings.getU32("AsyncLoggingDropPolicy"), (U32)LLError::ASYNC_WRITE_THROUGH);
+		LLError::startAsyncLogging(gSavedSettings.getU32("AsyncLoggingQueueSize"), (LLError::EAsyncDropPolicy)policy);
+	}
 	
 	LLWeb::initClass();			  // do this after LLUI
 
@@ -1142,6 +1171,10 @@ bool LLAppViewer::mainLoop()
 	while (!LLApp::isExiting())
 	{
 		LLFastTimer::nextFrame(); // Should be outside of any timer instances
+		if (gTimerLog)
+		{
+			LLFastTimer::writeJSONLog(*gTimerLog);
+		}
 
 		//clear call stack records
 		llclearcallstacks;
@@ -1539,6 +1572,17 @@ bool LLAppViewer::cleanup()
 
 	LLCalc::cleanUp();
 
+	// Write out chat lines still waiting in the log writer.
+	LLLogChat::cleanup();
+
+	if (gTimerLog)
+	{
+		LLFastTimer::sLog = FALSE;
+		LLFastTimer::writeJSONLog(*gTimerLog);
+		delete gTimerLog;
+		gTimerLog = NULL;
+	}
+
 	llinfos << "Global stuff deleted" << llendflush;
 
 	// Note: this is where LLFeatureManager::getInstance()-> used to be deleted.
@@ -1819,8 +1863,11 @@ bool LLAppViewer::cleanup()
 	end_messaging_system();
 	llinfos << "Message system deleted." << llendflush;
 
+	LLError::stopAsyncLogging();
+
 	LLApp::stopErrorThread();			// The following call is not thread-safe. Have to stop all threads.
 	stopEngineThread();
+	AICurlInterface::writeHTTPTimingStats(gDirUtilp->getExpandedFilename(LL_PATH_LOGS, "http_timings.xml"));
 	AICurlInterface::cleanupCurl();
 
 	// Cleanup settings last in case other classes reference them.
@@ -131,6 +131,36 @@ void LLFastTimerView::onPauseHandler(void *data)
 	((LLFastTimerView*)data)->onPause();
 }
 
+void LLFastTimerView::onTrace()
+{
+	if (!LLFastTimer::isTracing())
+	{
+		LLFastTimer::startTrace();
+		getChild<LLButton>("trace_btn")->setLabel(getString("stop_trace"));
+		return;
+	}
+
+	LLFastTimer::stopTrace();
+	getChild<LLButton>("trace_btn")->setLabel(getString("trace"));
+
+	std::string filename = gDirUtilp->getExpandedFilename(LL_PATH_LOGS, "fast_timer_trace.json");
+	llofstream os(filename);
+	if (os.is_open())
+	{
+		LLFastTimer::writeChromeTrace(os);
+		llinfos << "Wrote fast timer trace to " << filename << llendl;
+	}
+	else
+	{
+		llwarns << "Unable to open " << filename << " for writing." << llendl;
+	}
+}
+
+void LLFastTimerView::onTraceHandler(void *data)
+{
+	((LLFastTimerView*)data)->onTrace();
+}
+
 BOOL LLFastTimerView::postBuild()
 {
 	LLButton& pause_btn = getChildRef<LLButton>("pause_btn");
@@ -138,6 +168,8 @@ BOOL LLFastTimerView::postBuild()
 	pause_btn.setClickedCallback(&LLFastTimerView::onPauseHandler,this);
 	//pause_btn.setCommitCallback(boost::bind(&LLFastTimerView::onPause, this));
 
+	getChildRef<LLButton>("trace_btn").setClickedCallback(&LLFastTimerView::onTraceHandler, this);
+
 	return TRUE;
 }
 
@@ -53,6 +53,8 @@ private:
 	static void exportCharts(const std::string& base, const std::string& target);
 	void onPause();
 	static void onPauseHandler(void *data);
+	void onTrace();
+	static void onTraceHandler(void *data);
 
 public:
 
@@ -1544,26 +1544,35 @@ bool LLModelLoader::doLoadModel()
 	rotation *= mTransform;
 	mTransform = rotation;
 
+	std::vector<domMesh*> meshes;
 	for (daeInt idx = 0; idx < count; ++idx)
-	{	//build map of domEntities to LLModel
+	{
 		domMesh* mesh = NULL;
 		db->getElement((daeElement**) &mesh, idx, NULL, COLLADA_TYPE_MESH);
 
 		if (mesh)
 		{
-			LLPointer<LLModel> model = LLModel::loadModelFromDomMesh(mesh);
+			meshes.push_back(mesh);
+		}
+	}
 
-			if (model->getStatus() != LLModel::NO_ERRORS)
-			{
-				setLoadState(ERROR_PARSING + model->getStatus());
-				return false; //abort
-			}
+	model_list models;
+	LLModel::loadModelsFromDomMeshes(meshes, models);
 
-			if (model.notNull() && validate_model(model))
-			{
-				mModelList.push_back(model);
-				mModel[mesh] = model;
-			}
+	for (U32 i = 0; i < models.size(); ++i)
+	{	//build map of domEntities to LLModel
+		LLPointer<LLModel> model = models[i];
+
+		if (model->getStatus() != LLModel::NO_ERRORS)
+		{
+			setLoadState(ERROR_PARSING + model->getStatus());
+			return false; //abort
+		}
+
+		if (model.notNull() && validate_model(model))
+		{
+			mModelList.push_back(model);
+			mModel[meshes[i]] = model;
 		}
 	}
 
@@ -3777,18 +3786,12 @@ void LLModelPreview::generateNormals()
 
 	if (which_lod == 3 && !mBaseModel.empty())
 	{
-		for (LLModelLoader::model_list::iterator iter = mBaseModel.begin(); iter != mBaseModel.end(); ++iter)
-		{
-			(*iter)->generateNormals(angle_cutoff);
-		}
+		LLModel::generateNormals(mBaseModel, angle_cutoff);
 
 		mVertexBuffer[5].clear();
 	}
 
-	for (LLModelLoader::model_list::iterator iter = mModel[which_lod].begin(); iter != mModel[which_lod].end(); ++iter)
-	{
-		(*iter)->generateNormals(angle_cutoff);
-	}
+	LLModel::generateNormals(mModel[which_lod], angle_cutoff);
 
 	mVertexBuffer[which_lod].clear();
 	refresh();
@@ -327,6 +327,16 @@ void LLFloaterStats::buildStats()
 	stat_barp->setUnitLabel(" ");
 	stat_barp->mPerSec = FALSE;
 
+	stat_barp = net_statviewp->addStat("Asset Downloads", &(LLViewerStats::getInstance()->mAssetDownloadsInFlight),
+									   "DebugStatModeAssetDownloads");
+	stat_barp->setUnitLabel(" ");
+	stat_barp->mPerSec = FALSE;
+
+	stat_barp = net_statviewp->addStat("Joined Asset Requests", &(LLViewerStats::getInstance()->mAssetDownloadsCoalesced),
+									   "DebugStatModeAssetRequestsJoined");
+	stat_barp->setUnitLabel("/sec");
+	stat_barp->mPerSec = TRUE;
+
 
 	// Simulator stats
 	params.name("sim stat view");
@@ -118,6 +118,7 @@ LLFolderViewItem::LLFolderViewItem( const std::string& name, LLUIImagePtr icon,
 	mIconOverlay(icon_overlay),
 	mListener(listener),
 	mShowLoadStatus(true),
+	mSearchableSignature(0),
 	mSearchType(0)
 {
 	postBuild();//Not parsing xml file yet.
@@ -646,6 +647,7 @@ void LLFolderViewItem::updateSearchLabelType()
 		}
 		mSearchable += mSearchableLabelCreator;
 	}
+	mSearchableSignature = LLInventoryFilter::getSearchSignature(mSearchable);
 }
 
 const std::string& LLFolderViewItem::getSearchableLabel()
@@ -142,6 +142,7 @@ protected:
 	bool						mShowLoadStatus;
 
 	std::string					mSearchable;
+	U64							mSearchableSignature;	// LLInventoryFilter::getSearchSignature(mSearchable)
 	U32							mSearchType;
 	
 	// helper function to change the selection from the root.
@@ -254,6 +255,8 @@ public:
 	const std::string& getName( void ) const;
 
 	const std::string& getSearchableLabel( void );
+	// Only valid after getSearchableLabel() has been called.
+	U64 getSearchableSignature() const { return mSearchableSignature; }
 
 	// This method returns the label displayed on the view. This
 	// method was primarily added to allow sorting on the folder
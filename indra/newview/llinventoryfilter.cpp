@@ -72,6 +72,7 @@ LLInventoryFilter::LLInventoryFilter(const std::string& name)
 
 	mSubStringMatchOffset = 0;
 	mFilterSubString.clear();
+	mFilterSubStringSignature = 0;
 	mFilterGeneration = 0;
 	mMustPassGeneration = S32_MAX;
 	mMinRequiredGeneration = 0;
@@ -103,7 +104,20 @@ BOOL LLInventoryFilter::check(LLFolderViewItem* item)
 		return passed_clipboard;
 	}
 
-	mSubStringMatchOffset = mFilterSubString.size() ? item->getSearchableLabel().find(mFilterSubString) : std::string::npos;
+	mSubStringMatchOffset = std::string::npos;
+	if (mFilterSubString.size())
+	{
+		const std::string& searchable = item->getSearchableLabel();
+		if ((item->getSearchableSignature() & mFilterSubStringSignature) == mFilterSubStringSignature)
+		{
+			mSubStringMatchOffset = searchable.find(mFilterSubString);
+		}
+		if (mSubStringMatchOffset == std::string::npos)
+		{
+			// No need to run the other checks.
+			return FALSE;
+		}
+	}
 
 	const BOOL passed_filtertype = checkAgainstFilterType(item);
 	const BOOL passed_permissions = checkAgainstPermissions(item);
@@ -464,6 +478,7 @@ void LLInventoryFilter::setFilterSubString(const std::string& string)
 			&& !filter_sub_string_new.substr(0, mFilterSubString.size()).compare(mFilterSubString);
 
 		mFilterSubString = filter_sub_string_new;
+		mFilterSubStringSignature = getSearchSignature(mFilterSubString);
 		if (less_restrictive)
 		{
 			setModified(FILTER_LESS_RESTRICTIVE);
@@ -493,6 +508,20 @@ void LLInventoryFilter::setFilterSubString(const std::string& string)
 	}
 }
 
+//static
+U64 LLInventoryFilter::getSearchSignature(const std::string& str)
+{
+	U64 signature = 0;
+	const U8* chars = (const U8*)str.data();
+	for (size_t i = 1; i < str.size(); ++i)
+	{
+		// Fibonacci hash of the pair, top 6 bits select one of 64.
+		U32 pair = ((U32)chars[i - 1] << 8) | chars[i];
+		signature |= (U64)1 << ((pair * 2654435761U) >> 26);
+	}
+	return signature;
+}
+
 void LLInventoryFilter::setFilterPermissions(PermissionMask perms)
 {
 	if (mFilterOps.mPermissions != perms)
@@ -96,6 +96,12 @@ public:
 	const std::string& 	getFilterSubString(BOOL trim = FALSE) const;
 	const std::string& 	getFilterSubStringOrig() const { return mFilterSubStringOrig; } 
 	BOOL 				hasFilterString() const;
+
+	// Bitmask of the character pairs in an (upper case) string. A searchable
+	// label can only contain the filter substring if its signature has all
+	// the bits of the substring's signature set, which lets check() reject
+	// most items without searching their label.
+	static U64			getSearchSignature(const std::string& str);
 	
 	void setFilterWorn(bool worn) { mFilterOps.mFilterWorn = worn; }
 	bool getFilterWorn() const { return mFilterOps.mFilterWorn; }
@@ -206,6 +212,7 @@ private:
 
 	std::string::size_type	mSubStringMatchOffset;
 	std::string				mFilterSubString;
+	U64						mFilterSubStringSignature;
 	std::string				mFilterSubStringOrig;
 	const std::string		mName;
 
@@ -33,6 +33,7 @@
 #include "llframetimer.h"
 #include "llhttpclient.h"
 #include "lluuid.h"
+#include "lluuidhashmap.h"
 #include "llpermissionsflags.h"
 #include "llstring.h"
 
@@ -155,8 +156,9 @@ private:
 	// the inventory using several different identifiers.
 	// mInventory member data is the 'master' list of inventory, and
 	// mCategoryMap and mItemMap store uuid->object mappings. 
-	typedef std::map<LLUUID, LLPointer<LLViewerInventoryCategory> > cat_map_t;
-	typedef std::map<LLUUID, LLPointer<LLViewerInventoryItem> > item_map_t;
+	// They are looked up constantly and never need ordered iteration.
+	typedef LLUUIDHashMap<LLPointer<LLViewerInventoryCategory> > cat_map_t;
+	typedef LLUUIDHashMap<LLPointer<LLViewerInventoryItem> > item_map_t;
 	cat_map_t mCategoryMap;
 	item_map_t mItemMap;
 	// This last set of indices is used to map parents to children.
@@ -33,6 +33,9 @@
 #include "llviewerprecompiledheaders.h"
 
 #include <ctime>
+#include <deque>
+#include <map>
+#include "llthread.h"
 #include "lllogchat.h"
 #include "llappviewer.h"
 #include "llfloaterchat.h"
@@ -105,6 +108,138 @@ std::string LLLogChat::timestamp(bool withdate)
 }
 
 
+// Appends chat lines to their log files off the main thread. Opening and
+// closing a file for every line is slow on some systems (virus scanners
+// in particular), so recently used log files are kept open.
+class LLLogChatWriter : public LLThread
+{
+public:
+	LLLogChatWriter() : LLThread("Chat log writer") { }
+	~LLLogChatWriter() { closeFiles(); }
+
+	// Called from the main thread only.
+	void append(std::string const& path, std::string const& line)
+	{
+		{
+			LLMutexLock lock(mQueueMutex);
+			mQueue.push_back(std::make_pair(path, line));
+		}
+		// shutdown() deletes mRunCondition, so don't wake a thread that isn't running (anymore).
+		// The caller must flush() itself in that case.
+		if (!isStopped())
+		{
+			wake();
+		}
+	}
+
+	// Writes out everything appended so far. Can be called from any thread,
+	// also when the thread isn't running (anymore).
+	void flush()
+	{
+		LLMutexLock lock(mWriteMutex);
+		writeQueued();
+	}
+
+	void closeFiles()
+	{
+		LLMutexLock lock(mWriteMutex);
+		for (file_map_t::iterator iter = mFiles.begin(); iter != mFiles.end(); ++iter)
+		{
+			fclose(iter->second);
+		}
+		mFiles.clear();
+	}
+
+protected:
+	// Called with mRunCondition locked.
+	/*virtual*/ bool runCondition()
+	{
+		LLMutexLock lock(mQueueMutex);
+		return !mQueue.empty();
+	}
+
+	/*virtual*/ void run()
+	{
+		while (true)
+		{
+			checkPause();
+			if (isQuitting())
+			{
+				break;
+			}
+			flush();
+		}
+	}
+
+private:
+	// mWriteMutex must be locked.
+	void writeQueued()
+	{
+		queue_t queue;
+		{
+			LLMutexLock lock(mQueueMutex);
+			queue.swap(mQueue);
+		}
+		if (queue.empty())
+		{
+			return;
+		}
+
+		for (queue_t::iterator iter = queue.begin(); iter != queue.end(); ++iter)
+		{
+			LLFILE* fp = getFile(iter->first);
+			if (!fp)
+			{
+				llinfos << "Couldn't open chat history log!" << llendl;
+			}
+			else
+			{
+				fprintf(fp, "%s\n", iter->second.c_str());
+			}
+		}
+		// Don't keep lines in our buffers; loadHistory() and other programs read these files too.
+		for (file_map_t::iterator iter = mFiles.begin(); iter != mFiles.end(); ++iter)
+		{
+			fflush(iter->second);
+		}
+	}
+
+	LLFILE* getFile(std::string const& path)
+	{
+		file_map_t::iterator iter = mFiles.find(path);
+		if (iter != mFiles.end())
+		{
+			return iter->second;
+		}
+		static const size_t MAX_OPEN_LOGS = 16;
+		if (mFiles.size() >= MAX_OPEN_LOGS)
+		{
+			for (iter = mFiles.begin(); iter != mFiles.end(); ++iter)
+			{
+				fclose(iter->second);
+			}
+			mFiles.clear();
+		}
+		LLFILE* fp = LLFile::fopen(path, "a"); 		/*Flawfinder: ignore*/
+		if (fp)
+		{
+			mFiles[path] = fp;
+		}
+		return fp;
+	}
+
+	typedef std::deque<std::pair<std::string, std::string> > queue_t;
+	typedef std::map<std::string, LLFILE*> file_map_t;
+
+	queue_t mQueue;			// Protected by mQueueMutex
+	LLMutex mQueueMutex;	// Not mRunCondition, because that doesn't survive shutdown()
+	LLMutex mWriteMutex;	// Serializes writing, protects mFiles
+	file_map_t mFiles;
+};
+
+static LLLogChatWriter* sLogWriter = NULL;
+static bool sLogWriterStopped = false;
+
 //static
 void LLLogChat::saveHistory(std::string const& filename, std::string line)
 {
@@ -114,16 +249,33 @@ void LLLogChat::saveHistory(std::string const& filename, std::string line)
 		return;
 	}
 
-	LLFILE* fp = LLFile::fopen(LLLogChat::makeLogFileName(filename), "a"); 		/*Flawfinder: ignore*/
-	if (!fp)
+	if (!sLogWriter)
 	{
-		llinfos << "Couldn't open chat history log!" << llendl;
+		sLogWriter = new LLLogChatWriter;
+		if (!sLogWriterStopped)
+		{
+			sLogWriter->start();
+		}
 	}
-	else
+	sLogWriter->append(LLLogChat::makeLogFileName(filename), line);
+	if (sLogWriterStopped)
 	{
-		fprintf(fp, "%s\n", line.c_str());
-		
-		fclose (fp);
+		// Shutting down; write it out right away.
+		sLogWriter->flush();
+		sLogWriter->closeFiles();
+	}
+}
+
+//static
+void LLLogChat::cleanup()
+{
+	sLogWriterStopped = true;
+	if (sLogWriter)
+	{
+		// Stop the thread first, then write out whatever it didn't get to.
+		sLogWriter->shutdown();
+		sLogWriter->flush();
+		sLogWriter->closeFiles();
 	}
 }
 
@@ -138,6 +290,12 @@ void LLLogChat::loadHistory(std::string const& filename , void (*callback)(ELogL
 	}
 	else while(1)	// So we can use break.
 	{
+		// Make sure lines still queued for writing end up in the file first.
+		if (sLogWriter)
+		{
+			sLogWriter->flush();
+		}
+
 		// The number of lines to return.
 		static const LLCachedControl<U32> lines("LogShowHistoryLines", 32);
 		if (lines == 0) break;
@@ -51,6 +51,8 @@ public:
 	static void loadHistory(std::string const& filename, 
 		                    void (*callback)(ELogLineType,std::string,void*), 
 							void* userdata);
+	// Writes out pending lines and stops the log writer thread.
+	static void cleanup();
 private:
 	static std::string cleanFileName(std::string filename);
 };
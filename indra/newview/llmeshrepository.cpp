@@ -41,6 +41,7 @@
 #include "lleconomy.h"
 #include "llimagej2c.h"
 #include "llhost.h"
+#include "llmemorystream.h"
 #include "llnotificationsutil.h"
 #include "llsd.h"
 #include "llsdutil_math.h"
@@ -1044,20 +1045,18 @@ bool LLMeshRepoThread::headerReceived(const LLVolumeParams& mesh_params, U8* dat
 	U32 header_size = 0;
 	if (data_size > 0)
 	{
-		std::string res_str((char*) data, data_size);
+		static const std::string deprecated_header("<? LLSD/Binary ?>");
 
-		std::string deprecated_header("<? LLSD/Binary ?>");
-
-		if (res_str.substr(0, deprecated_header.size()) == deprecated_header)
+		if (data_size >= (S32) deprecated_header.size() &&
+			!memcmp(data, deprecated_header.data(), deprecated_header.size()))
 		{
-			res_str = res_str.substr(deprecated_header.size()+1, data_size);
-			header_size = deprecated_header.size()+1;
+			header_size = llmin((S32) deprecated_header.size()+1, data_size);
 		}
-		data_size = res_str.size();
 
-		std::istringstream stream(res_str);
+		// parse straight out of the received buffer
+		LLMemoryStream stream(data + header_size, data_size - (S32) header_size);
 
-		if (!LLSDSerialize::fromBinary(header, stream, data_size))
+		if (!LLSDSerialize::fromBinary(header, stream, data_size - (S32) header_size))
 		{
 			llwarns << "Mesh header parse error.  Not a valid mesh asset!" << llendl;
 			return false;
@@ -1104,11 +1103,9 @@ bool LLMeshRepoThread::lodReceived(const LLVolumeParams& mesh_params, S32 lod, U
 {
 	AIStateMachine::StateTimer timer("lodReceived");
 	LLPointer<LLVolume> volume = new LLVolume(mesh_params, LLVolumeLODGroup::getVolumeScaleFromDetail(lod));
-	std::string mesh_string((char*) data, data_size);
-	std::istringstream stream(mesh_string);
 
 	AIStateMachine::StateTimer timer2("unpackVolumeFaces");
-	if (volume->unpackVolumeFaces(stream, data_size))
+	if (volume->unpackVolumeFaces(data, data_size))
 	{
 		AIStateMachine::StateTimer timer("getNumFaces");
 		if (volume->getNumFaces() > 0)
@@ -1133,11 +1130,7 @@ bool LLMeshRepoThread::skinInfoReceived(const LLUUID& mesh_id, U8* data, S32 dat
 
 	if (data_size > 0)
 	{
-		std::string res_str((char*) data, data_size);
-
-		std::istringstream stream(res_str);
-
-		if (!unzip_llsd(skin, stream, data_size))
+		if (!unzip_llsd(skin, data, data_size))
 		{
 			llwarns << "Mesh skin info parse error.  Not a valid mesh asset!" << llendl;
 			return false;
@@ -1161,11 +1154,7 @@ bool LLMeshRepoThread::decompositionReceived(const LLUUID& mesh_id, U8* data, S3
 
 	if (data_size > 0)
 	{ 
-		std::string res_str((char*) data, data_size);
-
-		std::istringstream stream(res_str);
-
-		if (!unzip_llsd(decomp, stream, data_size))
+		if (!unzip_llsd(decomp, data, data_size))
 		{
 			llwarns << "Mesh decomposition parse error.  Not a valid mesh asset!" << llendl;
 			return false;
@@ -1198,10 +1187,8 @@ bool LLMeshRepoThread::physicsShapeReceived(const LLUUID& mesh_id, U8* data, S32
 		volume_params.setType(LL_PCODE_PROFILE_SQUARE, LL_PCODE_PATH_LINE);
 		volume_params.setSculptID(mesh_id, LL_SCULPT_TYPE_MESH);
 		LLPointer<LLVolume> volume = new LLVolume(volume_params,0);
-		std::string mesh_string((char*) data, data_size);
-		std::istringstream stream(mesh_string);
 
-		if (volume->unpackVolumeFaces(stream, data_size))
+		if (volume->unpackVolumeFaces(data, data_size))
 		{
 			//load volume faces into decomposition buffer
 			S32 vertex_count = 0;
@@ -1782,8 +1782,8 @@ void LLSpatialPartition::shift(const LLVector4a &offset)
 class LLOctreeCull : public LLSpatialGroup::OctreeTraveler
 {
 public:
-	LLOctreeCull(LLCamera* camera)
-		: mCamera(camera), mRes(0) { }
+	LLOctreeCull(LLCamera* camera, bool far_clip = false)
+		: mCamera(camera), mFrustum(*camera, far_clip), mRes(0) { }
 
 	virtual bool earlyFail(LLSpatialGroup* group)
 	{
@@ -1829,7 +1829,7 @@ public:
 	
 	virtual S32 frustumCheck(const LLSpatialGroup* group)
 	{
-		S32 res = mCamera->AABBInFrustumNoFarClip(group->mBounds[0], group->mBounds[1]);
+		S32 res = mFrustum.AABBInFrustum(group->mBounds[0], group->mBounds[1]);
 		if (res != 0)
 		{
 			res = llmin(res, AABBSphereIntersect(group->mExtents[0], group->mExtents[1], mCamera->getOrigin(), mCamera->mFrustumCornerDist));
@@ -1839,7 +1839,7 @@ public:
 
 	virtual S32 frustumCheckObjects(const LLSpatialGroup* group)
 	{
-		S32 res = mCamera->AABBInFrustumNoFarClip(group->mObjectBounds[0], group->mObjectBounds[1]);
+		S32 res = mFrustum.AABBInFrustum(group->mObjectBounds[0], group->mObjectBounds[1]);
 		if (res != 0)
 		{
 			res = llmin(res, AABBSphereIntersect(group->mObjectExtents[0], group->mObjectExtents[1], mCamera->getOrigin(), mCamera->mFrustumCornerDist));
@@ -1893,6 +1893,7 @@ public:
 	}
 
 	LLCamera *mCamera;
+	LLFrustum4a mFrustum;	// mCamera's planes, with the far clip plane for shadow culling
 	S32 mRes;
 };
 
@@ -1904,12 +1905,12 @@ public:
 
 	virtual S32 frustumCheck(const LLSpatialGroup* group)
 	{
-		return mCamera->AABBInFrustumNoFarClip(group->mBounds[0], group->mBounds[1]);
+		return mFrustum.AABBInFrustum(group->mBounds[0], group->mBounds[1]);
 	}
 
 	virtual S32 frustumCheckObjects(const LLSpatialGroup* group)
 	{
-		S32 res = mCamera->AABBInFrustumNoFarClip(group->mObjectBounds[0], group->mObjectBounds[1]);
+		S32 res = mFrustum.AABBInFrustum(group->mObjectBounds[0], group->mObjectBounds[1]);
 		return res;
 	}
 };
@@ -1918,16 +1919,16 @@ class LLOctreeCullShadow : public LLOctreeCull
 {
 public:
 	LLOctreeCullShadow(LLCamera* camera)
-		: LLOctreeCull(camera) { }
+		: LLOctreeCull(camera, true) { }
 
 	virtual S32 frustumCheck(const LLSpatialGroup* group)
 	{
-		return mCamera->AABBInFrustum(group->mBounds[0], group->mBounds[1]);
+		return mFrustum.AABBInFrustum(group->mBounds[0], group->mBounds[1]);
 	}
 
 	virtual S32 frustumCheckObjects(const LLSpatialGroup* group)
 	{
-		return mCamera->AABBInFrustum(group->mObjectBounds[0], group->mObjectBounds[1]);
+		return mFrustum.AABBInFrustum(group->mObjectBounds[0], group->mObjectBounds[1]);
 	}
 };
 
@@ -1982,7 +1983,7 @@ public:
 		
 		if (mRes < 2)
 		{
-			if (mCamera->AABBInFrustum(group->mObjectBounds[0], group->mObjectBounds[1]) > 0)
+			if (mFrustum.AABBInFrustum(group->mObjectBounds[0], group->mObjectBounds[1]) > 0)
 			{
 				mEmpty = FALSE;
 				update_min_max(mMin, mMax, group->mObjectExtents[0]);
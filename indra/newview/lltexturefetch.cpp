@@ -73,6 +73,10 @@ extern AIHTTPTimeoutPolicy assetReportHandler_timeout;
 LLStat LLTextureFetch::sCacheHitRate("texture_cache_hits", 128);
 LLStat LLTextureFetch::sCacheReadLatency("texture_cache_read_latency", 128);
 
+// Read by LLTextureFetchWorker::doWork() on the fetch thread.
+static LLAtomicControl<bool> sUseHTTP(gSavedSettings, "ImagePipelineUseHTTP", true);
+static LLAtomicControl<bool> sTextureDecodeDisabled(gSavedSettings, "TextureDecodeDisabled", false);
+
 //////////////////////////////////////////////////////////////////////////////
 class LLTextureFetchWorker : public LLWorkerClass
 {
@@ -1195,10 +1199,8 @@ bool LLTextureFetchWorker::doWork(S32 param)
 
 	if (mState == LOAD_FROM_NETWORK)
 	{
-		static LLCachedControl<bool> use_http(gSavedSettings,"ImagePipelineUseHTTP");
-
 // 		if (mHost != LLHost::invalid) use_http = false;
-		if (use_http && mCanUseHTTP && mUrl.empty())	// get http url.
+		if (sUseHTTP && mCanUseHTTP && mUrl.empty())	// get http url.
 		{
 			LLViewerRegion* region = NULL;
 			if (mHost == LLHost::invalid)
@@ -1717,10 +1719,8 @@ bool LLTextureFetchWorker::doWork(S32 param)
 	
 	if (mState == DECODE_IMAGE)
 	{
-		static LLCachedControl<bool> textures_decode_disabled(gSavedSettings,"TextureDecodeDisabled");
-
 		setPriority(LLWorkerThread::PRIORITY_LOW | mWorkPriority); // Set priority first since Responder may change it
-		if (textures_decode_disabled)
+		if (sTextureDecodeDisabled)
 		{
 			// for debug use, don't decode
 			setState(DONE);
@@ -356,7 +356,7 @@ void LLViewerAssetStorage::_queueDataRequest(
 			req->mMetricsStartTime = LLViewerAssetStatsFF::get_timestamp();
 		}
 		
-		mPendingDownloads.push_back(req);
+		addPendingDownload(req);
 	
 		if (!duplicate)
 		{
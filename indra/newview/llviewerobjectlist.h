@@ -39,7 +39,7 @@
 // common includes
 #include "llstat.h"
 #include "llstring.h"
-#include "sguuidhash.h"
+#include "lluuidhashmap.h"
 
 // project includes
 #include "llviewerobject.h"
@@ -217,10 +217,10 @@ public:
 
 	vobj_list_t mMapObjects;
 
-	std::set<LLUUID> mDeadObjects;	
+	LLUUIDHashSet mDeadObjects;	
 
-	boost::unordered_map<LLUUID, LLPointer<LLViewerObject> > mUUIDObjectMap;
-	boost::unordered_map<LLUUID, LLPointer<LLVOAvatar> > mUUIDAvatarMap;
+	LLUUIDHashMap<LLPointer<LLViewerObject> > mUUIDObjectMap;
+	LLUUIDHashMap<LLPointer<LLVOAvatar> > mUUIDAvatarMap;
 
 	//set of objects that need to update their cost
 	std::set<LLUUID> mStaleObjectCost;
@@ -272,7 +272,7 @@ extern LLViewerObjectList gObjectList;
 // Inlines
 inline LLViewerObject *LLViewerObjectList::findObject(const LLUUID &id) const
 {
-	boost::unordered_map<LLUUID, LLPointer<LLViewerObject> >::const_iterator iter = mUUIDObjectMap.find(id);
+	LLUUIDHashMap<LLPointer<LLViewerObject> >::const_iterator iter = mUUIDObjectMap.find(id);
 	if(iter != mUUIDObjectMap.end())
 	{
 		return iter->second;
@@ -285,7 +285,7 @@ inline LLViewerObject *LLViewerObjectList::findObject(const LLUUID &id) const
 
 inline LLVOAvatar *LLViewerObjectList::findAvatar(const LLUUID &id) const
 {
-	boost::unordered_map<LLUUID, LLPointer<LLVOAvatar> >::const_iterator iter = mUUIDAvatarMap.find(id);
+	LLUUIDHashMap<LLPointer<LLVOAvatar> >::const_iterator iter = mUUIDAvatarMap.find(id);
 	return (iter != mUUIDAvatarMap.end()) ? iter->second.get() : NULL;
 }
 
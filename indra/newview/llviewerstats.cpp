@@ -36,6 +36,7 @@
 #include "llviewerthrottle.h"
 
 #include "message.h"
+#include "llassetstorage.h"
 #include "lltimer.h"
 
 #include "llappviewer.h"
@@ -218,6 +219,8 @@ LLViewerStats::LLViewerStats() :
 	mUDPTextureKBitStat("udptexturekbitstat"),
 	mMallocStat("mallocstat"),
 	mVFSPendingOperations("vfspendingoperations"),
+	mAssetDownloadsInFlight("assetdownloadsinflight"),
+	mAssetDownloadsCoalesced("assetdownloadscoalesced"),
 	mObjectsDrawnStat("objectsdrawnstat"),
 	mObjectsCulledStat("objectsculledstat"),
 	mObjectsTestedStat("objectstestedstat"),
@@ -308,6 +311,8 @@ void LLViewerStats::resetStats()
 	stats.mHTTPTextureKBitStat.reset();
 	stats.mUDPTextureKBitStat.reset();
 	stats.mVFSPendingOperations.reset();
+	stats.mAssetDownloadsInFlight.reset();
+	stats.mAssetDownloadsCoalesced.reset();
 	stats.mAssetKBitStat.reset();
 	stats.mPacketsInStat.reset();
 	stats.mPacketsLostStat.reset();
@@ -648,6 +653,9 @@ void update_statistics()
 	stats.mVFSPendingOperations.addValue(LLVFile::getVFSThread()->getPending());
 	stats.mAssetKBitStat.addValue(gTransferManager.getTransferBitsIn(LLTCT_ASSET)/1024.f);
 	gTransferManager.resetTransferBitsIn(LLTCT_ASSET);
+	stats.mAssetDownloadsInFlight.addValue(gAssetStorage->getNumInFlightDownloads());
+	stats.mAssetDownloadsCoalesced.addValue(gAssetStorage->getNumCoalescedDownloads());
+	gAssetStorage->resetNumCoalescedDownloads();
 
 	if (LLAppViewer::getTextureFetch()->getNumRequests() == 0)
 	{
@@ -46,6 +46,8 @@ public:
 			mHTTPTextureKBitStat,
 			mUDPTextureKBitStat,
 			mVFSPendingOperations,
+			mAssetDownloadsInFlight,
+			mAssetDownloadsCoalesced,
 			mObjectsDrawnStat,
 			mObjectsCulledStat,
 			mObjectsTestedStat,
@@ -651,7 +651,7 @@ public:
 					}
 				}
 			}
-			for(std::set<LLUUID>::iterator it = gObjectList.mDeadObjects.begin();it!=gObjectList.mDeadObjects.end();++it)
+			for(LLUUIDHashSet::const_iterator it = gObjectList.mDeadObjects.begin();it!=gObjectList.mDeadObjects.end();++it)
 			{
 				LLViewerObject *obj = gObjectList.findObject(*it);
 				if(obj && obj->isAvatar())
@@ -299,6 +299,7 @@ void LLWorldMap::reset()
 	// Finally, clear the region map itself
 	for_each(mSimInfoMap.begin(), mSimInfoMap.end(), DeletePairedPointer());
 	mSimInfoMap.clear();
+	mSimIndex.clear();
 
 	mMapLoaded = false;
 	mMapLayers.clear();
@@ -391,14 +392,28 @@ LLSimInfo* LLWorldMap::simInfoFromHandle(const U64 handle)
 	}
 
 // <FS:CR> Aurora Sim
+	// Not the origin of a region: find the region cell the handle falls in,
+	// which is either a region of its own or part of a var-region.
 	U32 x = 0, y = 0;
 	from_region_handle(handle, &x, &y);
-	for (it = mSimInfoMap.begin(); it != mSimInfoMap.end(); ++it)
+	U64 cell_handle = to_region_handle(x - x % REGION_WIDTH_UNITS, y - y % REGION_WIDTH_UNITS);
+	LLSimInfo* info = NULL;
+	if (cell_handle != handle)
+	{
+		it = mSimInfoMap.find(cell_handle);
+		if (it != mSimInfoMap.end())
+		{
+			info = it->second;
+		}
+	}
+	if (!info)
+	{
+		info = mSimIndex.findCovering(cell_handle);
+	}
+	if (info)
 	{
 		U32 checkRegionX, checkRegionY;
-		from_region_handle((*it).first, &checkRegionX, &checkRegionY);
-
-		LLSimInfo* info = (*it).second;
+		from_region_handle(info->getHandle(), &checkRegionX, &checkRegionY);
 		if (x >= checkRegionX && x < (checkRegionX + info->getSizeX()) &&
 			y >= checkRegionY && y < (checkRegionY + info->getSizeY()))
 		{
@@ -412,25 +427,17 @@ LLSimInfo* LLWorldMap::simInfoFromHandle(const U64 handle)
 
 LLSimInfo* LLWorldMap::simInfoFromName(const std::string& sim_name)
 {
-	LLSimInfo* sim_info = NULL;
-	if (!sim_name.empty())
-	{
-		// Iterate through the entire sim info map and compare the name
-		sim_info_map_t::iterator it;
-		for (it = mSimInfoMap.begin(); it != mSimInfoMap.end(); ++it)
-		{
-			sim_info = it->second;
-			if (sim_info && sim_info->isName(sim_name) )
-			{
-				// break out of loop if success
-				break;
-			}
-		}
-		// If we got to the end, we haven't found the sim. Reset the ouput value to NULL.
-		if (it == mSimInfoMap.end())
-			sim_info = NULL;
-	}
-	return sim_info;
+	return mSimIndex.findByName(sim_name);
+}
+
+void LLWorldMap::indexSimInfo(LLSimInfo* sim_info)
+{
+	mSimIndex.add(sim_info, sim_info->getName(), sim_info->getHandle(), sim_info->getSizeX(), sim_info->getSizeY());
+}
+
+void LLWorldMap::unindexSimInfo(LLSimInfo* sim_info)
+{
+	mSimIndex.remove(sim_info, sim_info->getName(), sim_info->getHandle(), sim_info->getSizeX(), sim_info->getSizeY());
 }
 
 bool LLWorldMap::simNameFromPosGlobal(const LLVector3d& pos_global, std::string & outSimName )
@@ -590,6 +597,7 @@ bool LLWorldMap::insertRegion(U32 x_world, U32 y_world, U16 x_size, U16 y_size,
 		{
 			siminfo = LLWorldMap::getInstance()->createSimInfoFromHandle(handle);
 		}
+		LLWorldMap::getInstance()->unindexSimInfo(siminfo);
 		siminfo->setName(name);
 		siminfo->setAccess(accesscode);
 		siminfo->setRegionFlags(region_flags);
@@ -598,6 +606,7 @@ bool LLWorldMap::insertRegion(U32 x_world, U32 y_world, U16 x_size, U16 y_size,
 // <FS:CR> Aurora Sim
 		siminfo->setSize(x_size, y_size);
 // </FS:CR> Aurora Sim
+		LLWorldMap::getInstance()->indexSimInfo(siminfo);
 
 		// Handle the location tracking (for teleport, UI feedback and info display)
 		if (LLWorldMap::getInstance()->isTrackingInRectangle( x_world, y_world, x_world + REGION_WIDTH_UNITS, y_world + REGION_WIDTH_UNITS))
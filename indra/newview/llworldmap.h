@@ -42,6 +42,7 @@
 #include "llframetimer.h"
 #include "llmapimagetype.h"
 #include "llworldmipmap.h"
+#include "llworldmapindex.h"
 #include "lluuid.h"
 #include "llmemory.h"
 #include "llviewerregion.h"
@@ -334,6 +335,14 @@ private:
 	// Map from region-handle to simulator info
 	sim_info_map_t mSimInfoMap;
 
+	// Keep mSimIndex in sync with a region's name and size.
+	// Call unindexSimInfo() before changing either and indexSimInfo() after.
+	void indexSimInfo(LLSimInfo* sim_info);
+	void unindexSimInfo(LLSimInfo* sim_info);
+
+	// Lookups by region name and by var-region cell
+	LLWorldMapIndex mSimIndex;
+
 	// Request legacy background layers.
 	void sendMapLayerRequest();
 
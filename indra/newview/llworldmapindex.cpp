@@ -0,0 +1,138 @@
+/** 
+ * @file llworldmapindex.cpp
+ * @brief LLWorldMapIndex implementation
+ *
+ * $LicenseInfo:firstyear=2013LICENSE_LINElicense=viewergpl$
+ * 
+ * Copyright (c) 2013, Linden Research, Inc.
+ * 
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ * 
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ * 
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ * 
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "llworldmapindex.h"
+#include "indra_constants.h"
+#include "llregionhandle.h"
+
+// Duplicate names and overlapping var-regions are rare, so the ranges are short.
+template <class MAP>
+//static
+LLSimInfo* LLWorldMapIndex::findLowest(const MAP& map, const typename MAP::key_type& key)
+{
+	std::pair<typename MAP::const_iterator, typename MAP::const_iterator> range = map.equal_range(key);
+	const Entry* lowest = NULL;
+	for (typename MAP::const_iterator it = range.first; it != range.second; ++it)
+	{
+		if (!lowest || it->second.mHandle < lowest->mHandle)
+		{
+			lowest = &it->second;
+		}
+	}
+	return lowest ? lowest->mSimInfo : NULL;
+}
+
+template <class MAP>
+//static
+void LLWorldMapIndex::erase(MAP& map, const typename MAP::key_type& key, LLSimInfo* sim_info)
+{
+	std::pair<typename MAP::iterator, typename MAP::iterator> range = map.equal_range(key);
+	for (typename MAP::iterator it = range.first; it != range.second; ++it)
+	{
+		if (it->second.mSimInfo == sim_info)
+		{
+			map.erase(it);
+			return;
+		}
+	}
+}
+
+void LLWorldMapIndex::add(LLSimInfo* sim_info, const std::string& name, U64 handle, U32 size_x, U32 size_y)
+{
+	if (!name.empty())
+	{
+		std::string key(name);
+		LLStringUtil::toLower(key);
+		mSimNameMap.insert(std::make_pair(key, Entry(handle, sim_info)));
+	}
+
+	U32 origin_x, origin_y;
+	from_region_handle(handle, &origin_x, &origin_y);
+	for (U32 x = 0; x < size_x; x += REGION_WIDTH_UNITS)
+	{
+		for (U32 y = 0; y < size_y; y += REGION_WIDTH_UNITS)
+		{
+			if (x || y)
+			{
+				mSimCoverMap.insert(std::make_pair(to_region_handle(origin_x + x, origin_y + y), Entry(handle, sim_info)));
+			}
+		}
+	}
+}
+
+void LLWorldMapIndex::remove(LLSimInfo* sim_info, const std::string& name, U64 handle, U32 size_x, U32 size_y)
+{
+	// Other regions indexed under the same name or cell stay in the index.
+	if (!name.empty())
+	{
+		std::string key(name);
+		LLStringUtil::toLower(key);
+		erase(mSimNameMap, key, sim_info);
+	}
+
+	U32 origin_x, origin_y;
+	from_region_handle(handle, &origin_x, &origin_y);
+	for (U32 x = 0; x < size_x; x += REGION_WIDTH_UNITS)
+	{
+		for (U32 y = 0; y < size_y; y += REGION_WIDTH_UNITS)
+		{
+			if (x || y)
+			{
+				erase(mSimCoverMap, to_region_handle(origin_x + x, origin_y + y), sim_info);
+			}
+		}
+	}
+}
+
+void LLWorldMapIndex::clear()
+{
+	mSimNameMap.clear();
+	mSimCoverMap.clear();
+}
+
+LLSimInfo* LLWorldMapIndex::findByName(const std::string& name) const
+{
+	if (name.empty())
+	{
+		return NULL;
+	}
+	std::string key(name);
+	LLStringUtil::toLower(key);
+	return findLowest(mSimNameMap, key);
+}
+
+LLSimInfo* LLWorldMapIndex::findCovering(U64 cell_handle) const
+{
+	return findLowest(mSimCoverMap, cell_handle);
+}
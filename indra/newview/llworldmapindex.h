@@ -0,0 +1,79 @@
+/** 
+ * @file llworldmapindex.h
+ * @brief Name and var-region lookups for the regions of the world map.
+ *
+ * $LicenseInfo:firstyear=2013LICENSE_LINElicense=viewergpl$
+ * 
+ * Copyright (c) 2013, Linden Research, Inc.
+ * 
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ * 
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ * 
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ * 
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLWORLDMAPINDEX_H
+#define LL_LLWORLDMAPINDEX_H
+
+#include <string>
+#include <boost/unordered_map.hpp>
+
+class LLSimInfo;
+
+// Finds the regions of LLWorldMap by name and by the var-region cells they cover.
+// It only stores the LLSimInfo pointers it is given, so that it can be tested on its own.
+class LLWorldMapIndex
+{
+public:
+	// Call remove() with the old name and size before changing either, and add() after.
+	void add(LLSimInfo* sim_info, const std::string& name, U64 handle, U32 size_x, U32 size_y);
+	void remove(LLSimInfo* sim_info, const std::string& name, U64 handle, U32 size_x, U32 size_y);
+	void clear();
+
+	// Case insensitive. Of several regions with the same name, returns the one with the lowest handle.
+	LLSimInfo* findByName(const std::string& name) const;
+	// Returns the var-region covering the REGION_WIDTH_UNITS cell cell_handle, other than at its origin.
+	LLSimInfo* findCovering(U64 cell_handle) const;
+
+private:
+	struct Entry
+	{
+		Entry(U64 handle, LLSimInfo* sim_info) : mHandle(handle), mSimInfo(sim_info) { }
+		U64 mHandle;
+		LLSimInfo* mSimInfo;
+	};
+
+	template <class MAP>
+	static LLSimInfo* findLowest(const MAP& map, const typename MAP::key_type& key);
+	template <class MAP>
+	static void erase(MAP& map, const typename MAP::key_type& key, LLSimInfo* sim_info);
+
+	// Map from lower case region name to the regions of that name
+	typedef boost::unordered_multimap<std::string, Entry> sim_name_map_t;
+	sim_name_map_t mSimNameMap;
+
+	// Map from the handle of every REGION_WIDTH_UNITS cell covered by a var-region,
+	// other than its origin, to that region
+	typedef boost::unordered_multimap<U64, Entry> sim_cover_map_t;
+	sim_cover_map_t mSimCoverMap;
+};
+
+#endif // LL_LLWORLDMAPINDEX_H
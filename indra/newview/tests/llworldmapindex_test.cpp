@@ -0,0 +1,150 @@
+/** 
+ * @file llworldmapindex_test.cpp
+ * @brief Checks the LLWorldMap region lookups by name and by var-region cell.
+ *
+ * $LicenseInfo:firstyear=2013LICENSE_LINElicense=viewergpl$
+ * 
+ * Copyright (c) 2013, Linden Research, Inc.
+ * 
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ * 
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ * 
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ * 
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+
+// Precompiled header: almost always required for newview cpp files
+#include "../llviewerprecompiledheaders.h"
+// Class to test
+#include "../llworldmapindex.h"
+// Dependencies
+#include "indra_constants.h"
+#include "llregionhandle.h"
+// Tut header
+#include "../test/lltut.h"
+
+// -------------------------------------------------------------------------------------------
+// Stubbing: Declarations required to link and run the class being tested
+// The index only stores and compares LLSimInfo pointers.
+class LLSimInfo
+{
+};
+// End Stubbing
+// -------------------------------------------------------------------------------------------
+
+namespace tut
+{
+	// Test wrapper declarations
+	struct worldmapindex_test
+	{
+		LLWorldMapIndex mIndex;
+
+		U64 regionHandle(U32 grid_x, U32 grid_y)
+		{
+			return to_region_handle((1000 + grid_x) * REGION_WIDTH_UNITS, (2000 + grid_y) * REGION_WIDTH_UNITS);
+		}
+	};
+	typedef test_group<worldmapindex_test> worldmapindex_t;
+	typedef worldmapindex_t::object worldmapindex_object_t;
+	tut::worldmapindex_t tut_worldmapindex("LLWorldMapIndex");
+
+	// Name and var-region lookups on a large grid
+	template<> template<>
+	void worldmapindex_object_t::test<1>()
+	{
+		// 50000 regions, every 16th of them a 4x4 var-region to the right of the others
+		const U32 REGION_COUNT = 50000;
+		const U32 ROW_LENGTH = 250;
+		std::vector<LLSimInfo> sims(REGION_COUNT);
+		for (U32 i = 0; i < REGION_COUNT; ++i)
+		{
+			bool var_region = (i % 16) == 0;
+			U64 handle = var_region ? regionHandle(ROW_LENGTH + 4 * (i / 16 % 32), 4 * (i / 512)) : regionHandle(i % ROW_LENGTH, i / ROW_LENGTH);
+			U32 size = var_region ? 4 * REGION_WIDTH_UNITS : REGION_WIDTH_UNITS;
+			mIndex.add(&sims[i], llformat("Grid Sim %u", i), handle, size, size);
+		}
+
+		ensure("findByName() is case insensitive", mIndex.findByName("grid SIM 12345") == &sims[12345]);
+		ensure("findByName() unknown region", mIndex.findByName("Grid Sim") == NULL);
+		ensure("findByName() empty name", mIndex.findByName("") == NULL);
+
+		// Every cell of the var-region Grid Sim 32, except its origin
+		U64 origin = regionHandle(ROW_LENGTH + 8, 0);
+		U32 origin_x, origin_y;
+		from_region_handle(origin, &origin_x, &origin_y);
+		for (U32 x = 0; x < 4 * REGION_WIDTH_UNITS; x += REGION_WIDTH_UNITS)
+		{
+			for (U32 y = 0; y < 4 * REGION_WIDTH_UNITS; y += REGION_WIDTH_UNITS)
+			{
+				LLSimInfo* expected = (x || y) ? &sims[32] : NULL;
+				ensure("findCovering() inside var-region", mIndex.findCovering(to_region_handle(origin_x + x, origin_y + y)) == expected);
+			}
+		}
+		ensure("findCovering() neighbouring var-region", mIndex.findCovering(to_region_handle(origin_x + 5 * REGION_WIDTH_UNITS, origin_y)) == &sims[48]);
+		ensure("findCovering() regular region", mIndex.findCovering(regionHandle(1, 0)) == NULL);
+
+		// Rename and shrink Grid Sim 32
+		mIndex.remove(&sims[32], "Grid Sim 32", origin, 4 * REGION_WIDTH_UNITS, 4 * REGION_WIDTH_UNITS);
+		mIndex.add(&sims[32], "Renamed Sim", origin, REGION_WIDTH_UNITS, REGION_WIDTH_UNITS);
+		ensure("findByName() old name", mIndex.findByName("Grid Sim 32") == NULL);
+		ensure("findByName() new name", mIndex.findByName("Renamed Sim") == &sims[32]);
+		ensure("findCovering() shrunk var-region", mIndex.findCovering(to_region_handle(origin_x + REGION_WIDTH_UNITS, origin_y)) == NULL);
+
+		mIndex.clear();
+		ensure("findByName() after clear", mIndex.findByName("Renamed Sim") == NULL);
+		ensure("findCovering() after clear", mIndex.findCovering(regionHandle(ROW_LENGTH + 1, 0)) == NULL);
+	}
+
+	// Regions that share a name, and var-regions that overlap
+	template<> template<>
+	void worldmapindex_object_t::test<2>()
+	{
+		LLSimInfo first, second, third;
+		U64 first_handle = regionHandle(5, 0);
+		U64 second_handle = regionHandle(3, 0);
+		U64 third_handle = regionHandle(4, 0);
+		mIndex.add(&first, "Same Name", first_handle, REGION_WIDTH_UNITS, REGION_WIDTH_UNITS);
+		mIndex.add(&second, "same name", second_handle, REGION_WIDTH_UNITS, REGION_WIDTH_UNITS);
+		mIndex.add(&third, "SAME NAME", third_handle, REGION_WIDTH_UNITS, REGION_WIDTH_UNITS);
+		ensure("findByName() lowest handle", mIndex.findByName("Same Name") == &second);
+
+		// Renaming one of them leaves the others found
+		mIndex.remove(&second, "same name", second_handle, REGION_WIDTH_UNITS, REGION_WIDTH_UNITS);
+		mIndex.add(&second, "Other Name", second_handle, REGION_WIDTH_UNITS, REGION_WIDTH_UNITS);
+		ensure("findByName() renamed", mIndex.findByName("Other Name") == &second);
+		ensure("findByName() next lowest handle", mIndex.findByName("Same Name") == &third);
+		mIndex.remove(&third, "SAME NAME", third_handle, REGION_WIDTH_UNITS, REGION_WIDTH_UNITS);
+		ensure("findByName() last one", mIndex.findByName("Same Name") == &first);
+		mIndex.remove(&first, "Same Name", first_handle, REGION_WIDTH_UNITS, REGION_WIDTH_UNITS);
+		ensure("findByName() all removed", mIndex.findByName("Same Name") == NULL);
+
+		// A 2x2 var-region overlapping a 3x3 one: the cell they share stays covered by the other
+		U64 big_handle = regionHandle(10, 10);
+		U64 small_handle = regionHandle(11, 11);
+		U64 shared_cell = regionHandle(12, 12);
+		mIndex.add(&first, "Big", big_handle, 3 * REGION_WIDTH_UNITS, 3 * REGION_WIDTH_UNITS);
+		mIndex.add(&third, "Small", small_handle, 2 * REGION_WIDTH_UNITS, 2 * REGION_WIDTH_UNITS);
+		ensure("findCovering() lowest handle", mIndex.findCovering(shared_cell) == &first);
+		mIndex.remove(&first, "Big", big_handle, 3 * REGION_WIDTH_UNITS, 3 * REGION_WIDTH_UNITS);
+		ensure("findCovering() other var-region", mIndex.findCovering(shared_cell) == &third);
+		ensure("findCovering() removed var-region", mIndex.findCovering(regionHandle(10, 11)) == NULL);
+	}
+}
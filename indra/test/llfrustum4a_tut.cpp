@@ -0,0 +1,207 @@
+/**
+ * @file llfrustum4a_tut.cpp
+ * @brief Checks LLFrustum4a against LLCamera::AABBInFrustum.
+ *
+ * $LicenseInfo:firstyear=2013&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * $/LicenseInfo$
+ */
+
+#include <tut/tut.hpp>
+#include "linden_common.h"
+#include "lltut.h"
+#include "llcamera.h"
+#include "llquaternion.h"
+#include "llrand.h"
+
+namespace tut
+{
+	struct frustum4a_data
+	{
+		LLCamera mCamera;
+		bool mUserClip;
+
+		frustum4a_data() : mUserClip(false)
+		{
+		}
+
+		static LLVector3 randomVector(F32 scale)
+		{
+			return LLVector3(ll_frand(2.f * scale) - scale, ll_frand(2.f * scale) - scale, ll_frand(2.f * scale) - scale);
+		}
+
+		// A perspective camera at a random place and orientation, with its
+		// agent planes calculated from the frustum corners like LLViewerCamera does.
+		void setRandomCamera()
+		{
+			mCamera = LLCamera(0.3f + ll_frand(2.f), 0.5f + ll_frand(2.f), 768, 0.1f + ll_frand(2.f), 20.f + ll_frand(200.f));
+			mCamera.setOrigin(randomVector(100.f));
+			LLVector3 axis = randomVector(1.f);
+			if (axis.normVec() == 0.f)
+			{
+				axis = LLVector3::z_axis;
+			}
+			mCamera.setAxes(LLQuaternion(ll_frand(F_TWO_PI), axis));
+			mUserClip = false;
+
+			F32 tan_half_fov = tanf(mCamera.getView() * 0.5f);
+			LLVector3 frust[LLCamera::AGENT_FRUSTRUM_NUM];
+			for (U32 i = 0; i < 2; i++)
+			{
+				F32 dist = i ? mCamera.getFar() : mCamera.getNear();
+				LLVector3 up = mCamera.getUpAxis() * (dist * tan_half_fov);
+				LLVector3 left = mCamera.getLeftAxis() * (dist * tan_half_fov * mCamera.getAspect());
+				LLVector3 center = mCamera.getOrigin() + mCamera.getAtAxis() * dist;
+				frust[4 * i + 0] = center + left - up;	// Left bottom
+				frust[4 * i + 1] = center - left - up;	// Right bottom
+				frust[4 * i + 2] = center - left + up;	// Right top
+				frust[4 * i + 3] = center + left + up;	// Left top
+			}
+			mCamera.calcAgentFrustumPlanes(frust);
+		}
+
+		void setUserClipPlane(const LLPlane& plane)
+		{
+			mCamera.setUserClipPlane(plane);
+			mUserClip = true;
+		}
+
+		// True when a box corner is so close to a plane that rounding could
+		// put it on either side; both tests are allowed to disagree there.
+		bool onBoundary(const LLVector4a& center, const LLVector4a& radius)
+		{
+			U32 planes = mUserClip ? LLCamera::AGENT_PLANE_USER_CLIP_NUM : LLCamera::AGENT_PLANE_NO_USER_CLIP_NUM;
+			for (U32 i = 0; i < planes; i++)
+			{
+				const LLPlane& p = mCamera.getAgentPlane(i);
+				F32 dist = p[0] * center[0] + p[1] * center[1] + p[2] * center[2] + p[3];
+				F32 reach = fabsf(p[0]) * radius[0] + fabsf(p[1]) * radius[1] + fabsf(p[2]) * radius[2];
+				if (fabsf(dist - reach) < 0.01f || fabsf(dist + reach) < 0.01f)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		// Compares random boxes around the camera, counting the results per outcome.
+		void compare(S32 boxes, S32* results)
+		{
+			LLFrustum4a frustum(mCamera);
+			LLFrustum4a frustum_no_far(mCamera, false);
+			F32 far_plane = mCamera.getFar();
+			for (S32 i = 0; i < boxes; i++)
+			{
+				LLVector4a center, radius;
+				center.load3((mCamera.getOrigin() + randomVector(far_plane * 1.2f)).mV);
+				if (i % 8 == 0)
+				{	// A point
+					radius.clear();
+				}
+				else
+				{
+					radius.load3(LLVector3(ll_frand(far_plane * 0.2f), ll_frand(far_plane * 0.2f), ll_frand(far_plane * 0.2f)).mV);
+				}
+				if (onBoundary(center, radius))
+				{
+					continue;
+				}
+
+				S32 expected = mCamera.AABBInFrustum(center, radius);
+				ensure_equals("AABBInFrustum", frustum.AABBInFrustum(center, radius), expected);
+				ensure_equals("AABBInFrustumNoFarClip", frustum_no_far.AABBInFrustum(center, radius), mCamera.AABBInFrustumNoFarClip(center, radius));
+				results[expected]++;
+			}
+		}
+	};
+	typedef test_group<frustum4a_data> frustum4a_test;
+	typedef frustum4a_test::object frustum4a_object;
+	tut::frustum4a_test frustum4a_testcase("frustum4a");
+
+	// The planes that are left out: the far plane, ignored planes and the unused slots.
+	template<> template<>
+	void frustum4a_object::test<1>()
+	{
+		setRandomCamera();
+		LLVector4a center, radius;
+		center.load3((mCamera.getOrigin() + mCamera.getAtAxis() * (mCamera.getFar() * 1.5f)).mV);
+		radius.splat(0.01f);
+		LLFrustum4a frustum(mCamera);
+		LLFrustum4a frustum_no_far(mCamera, false);
+		ensure_equals("beyond the far plane", mCamera.AABBInFrustum(center, radius), 0);
+		ensure_equals("beyond the far plane, no far clip", mCamera.AABBInFrustumNoFarClip(center, radius), 2);
+		ensure_equals("LLFrustum4a beyond the far plane", frustum.AABBInFrustum(center, radius), 0);
+		ensure_equals("LLFrustum4a beyond the far plane, no far clip", frustum_no_far.AABBInFrustum(center, radius), 2);
+
+		// An ignored plane is cleared to 0, 0, 0, 1, which every box is outside of.
+		for (S32 i = 0; i < LLCamera::AGENT_PLANE_NO_USER_CLIP_NUM; i++)
+		{
+			mCamera.ignoreAgentFrustumPlane(i);
+		}
+		center.load3(randomVector(1000.f).mV);
+		ensure_equals("all planes ignored", mCamera.AABBInFrustum(center, radius), 2);
+		ensure_equals("LLFrustum4a all planes ignored", LLFrustum4a(mCamera).AABBInFrustum(center, radius), 2);
+		ensure_equals("LLFrustum4a all planes ignored, no far clip", LLFrustum4a(mCamera, false).AABBInFrustum(center, radius), 2);
+	}
+
+	// Random cameras and boxes.
+	template<> template<>
+	void frustum4a_object::test<2>()
+	{
+		S32 results[3] = { 0, 0, 0 };
+		for (S32 i = 0; i < 200; i++)
+		{
+			setRandomCamera();
+			compare(500, results);
+		}
+		// Make sure the boxes didn't all end up on the same side.
+		ensure("boxes outside", results[0] > 1000);
+		ensure("boxes partly inside", results[1] > 1000);
+		ensure("boxes inside", results[2] > 1000);
+	}
+
+	// Random cameras with a user clip plane, a stale user clip plane, and ignored planes.
+	template<> template<>
+	void frustum4a_object::test<3>()
+	{
+		S32 results[3] = { 0, 0, 0 };
+		for (S32 i = 0; i < 200; i++)
+		{
+			setRandomCamera();
+			LLVector3 normal = randomVector(1.f);
+			if (normal.normVec() == 0.f)
+			{
+				normal = LLVector3::x_axis;
+			}
+			setUserClipPlane(LLPlane(mCamera.getOrigin() + mCamera.getAtAxis() * ll_frand(mCamera.getFar()), normal));
+			if (i % 4 == 0)
+			{	// The plane and its mask are kept, but no longer used
+				mCamera.disableUserClipPlane();
+				mUserClip = false;
+			}
+			S32 planes = mUserClip ? LLCamera::AGENT_PLANE_USER_CLIP_NUM : LLCamera::AGENT_PLANE_NO_USER_CLIP_NUM;
+			S32 ignored = ll_rand(planes + 1);
+			if (ignored < planes)
+			{
+				mCamera.ignoreAgentFrustumPlane(ignored);
+			}
+			compare(500, results);
+		}
+		ensure("boxes outside", results[0] > 1000);
+		ensure("boxes partly inside", results[1] > 1000);
+	}
+}